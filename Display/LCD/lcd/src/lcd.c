@@ -10,9 +10,46 @@
 /* Includes -------------------------------------------*/
 #include "lcd.h"
 #include "lcd_cfg.h"
+#include <stdarg.h>
 
 /* Variables ------------------------------------------*/
-static uint8_t displayControl = 0x00; /* Used for storing the display information */
+static uint8_t batchBuffer[LCD_TRANSFER_MAX_SIZE]; /* Encoded packets waiting to be transmitted */
+static uint16_t batchLength = 0u;
+static uint16_t batchLimit = LCD_BATCH_MAX_SIZE; /* Size at which the batch is sent, LCD_FRAME_STREAM_SIZE for a frame commit */
+static st_LCDHandle *batchHandle = NULL; /* LCD the batch is sent to */
+static uint8_t batchSlots = 0u; /* CGRAM slots written by the batch, one bit per slot */
+static const uint8_t *glyphTable[LCD_GLYPH_MAX]; /* Registered glyphs, NULL if not registered */
+static uint16_t glyphVersion[LCD_GLYPH_MAX]; /* Incremented by each registration of the glyph */
+
+/* Execution time of the instructions in us, indexed by the highest set bit of the instruction */
+static const uint16_t executionTime[8u] =
+{
+	LCD_EXEC_TIME_LONG,		/* Clear display */
+	LCD_EXEC_TIME_LONG,		/* Return home */
+	LCD_EXEC_TIME_SHORT,	/* Entry mode set */
+	LCD_EXEC_TIME_SHORT,	/* Display on/off control */
+	LCD_EXEC_TIME_SHORT,	/* Cursor or display shift */
+	LCD_EXEC_TIME_SHORT,	/* Function set */
+	LCD_EXEC_TIME_SHORT,	/* Set CGRAM address */
+	LCD_EXEC_TIME_SHORT		/* Set DDRAM address */
+};
+#if(LCD_ASYNC_TRANSMIT == 1u)
+/* Transmit queue, written by the application and drained by the transmit complete interrupt */
+static uint8_t transmitQueue[LCD_QUEUE_SIZE];
+static volatile uint16_t queueHead = 0u; /* Written by the application only */
+static volatile uint16_t queueTail = 0u; /* Written by the interrupt only, or rewound while the queue is idle */
+static volatile uint16_t transferLength = 0u; /* Size of the transmit in progress, 0 when idle */
+static volatile e_Status queueStatus = STATUS_OK; /* STATUS_NOT_OK after a bus error, until LCD_WaitComplete() */
+static volatile uint32_t queueDropCount = 0u; /* Incremented by each bus error, the LCD content is then unknown */
+static pf_TransmitCallback transmitCallback = NULL;
+
+/* Segments of the queue, each one transmitted to one LCD */
+static st_LCDHandle *segmentHandle[LCD_QUEUE_SEGMENTS];
+static uint16_t segmentLength[LCD_QUEUE_SEGMENTS];
+static volatile uint8_t segmentHead = 0u; /* Written by the application only */
+static volatile uint8_t segmentTail = 0u; /* Written by the interrupt only, or rewound while the queue is idle */
+static volatile uint16_t segmentSent = 0u; /* Bytes of the tail segment already transmitted */
+#endif
 
 /* Static Function Declaration ------------------------*/
 
@@ -23,153 +60,1987 @@ static uint8_t displayControl = 0x00; /* Used for storing the display informatio
  * It divides the byte into two nibbles and transmits
  * each nibble sequentially.
  *
+ * @param  lcd Context of the LCD.
+ * @param  cmd The command byte to be sent.
+ * @return e_Status Returns the status of the transmission.
+ */
+e_Status LCD_CommandWrite(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Sends data to the LCD.
+ *
+ * This function sends a data byte to the LCD.
+ * It divides the byte into two nibbles and transmits
+ * each nibble sequentially.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  data The data byte to be sent.
+ * @return e_Status Returns the status of the transmission.
+ */
+e_Status LCD_DataWrite(st_LCDHandle *lcd, uint8_t data);
+
+/**
+ * @brief  Encodes a byte in a PCF8574 packet.
+ *
+ * The byte is divided into two nibbles, each one latched with an enable high then low.
+ * Shared by every LCD instance.
+ *
+ * @param  value The command or data byte.
+ * @param  modeBits LCD_SEND_DATA for data, 0 for a command.
+ * @param  backlight LCD_BACKLIGHT_ON or 0.
+ * @param  packet Pointer to store the LCD_PACKET_SZ bytes of the packet.
+ */
+static void LCD_EncodePacket(uint8_t value, uint8_t modeBits, uint8_t backlight, uint8_t *packet);
+
+/**
+ * @brief  Adds a byte to the batch, the batch is sent first if it is full (batchLimit)
+ *         or holds the bytes of another LCD.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  value The command or data byte.
+ * @param  modeBits LCD_SEND_DATA for data, 0 for a command.
+ * @return e_Status Returns the status of the transmission of the full batch, STATUS_OK otherwise.
+ */
+static e_Status LCD_BatchAppend(st_LCDHandle *lcd, uint8_t value, uint8_t modeBits);
+
+/**
+ * @brief  Sends the batch in one I2C transmit.
+ *
+ * @return e_Status Returns the status of the transmission, STATUS_OK if the batch is empty.
+ */
+static e_Status LCD_BatchSend();
+
+/**
+ * @brief  Drops the batch after an error, the content of its LCD is unknown.
+ */
+static void LCD_BatchDiscard();
+
+/**
+ * @brief  Sends bytes to the PCF8574 of an LCD, queued with the asynchronous transmit.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  data Pointer to the bytes.
+ * @param  size The number of bytes.
+ * @return e_Status Returns the status of the transmission.
+ */
+static e_Status LCD_PortWrite(st_LCDHandle *lcd, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Follows the address counter and the DDRAM content of the LCD.
+ *
+ * The characters are recorded in the shadow of the framebuffer whichever function sends them.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  value The command or data byte sent.
+ * @param  modeBits LCD_SEND_DATA for data, 0 for a command.
+ */
+static void LCD_TrackAddress(st_LCDHandle *lcd, uint8_t value, uint8_t modeBits);
+
+/**
+ * @brief  Records a character written in the DDRAM in the shadow of the framebuffer.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  address The DDRAM address of the character, ignored if not displayed in a cell.
+ * @param  character The character.
+ */
+static void LCD_ShadowWrite(st_LCDHandle *lcd, uint8_t address, uint8_t character);
+
+/**
+ * @brief  Gets the set DDRAM address command of a cursor position.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position (0- rowCount).
+ * @param  colPos The column position (0- charCount).
+ * @param  cursorCmd Pointer to store the command.
+ * @return e_Status Returns STATUS_NOT_OK if the position is out of range.
+ */
+static e_Status LCD_GetCursorCommand(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, uint8_t *cursorCmd);
+
+/**
+ * @brief  Waits for the execution time of a command.
+ *
+ * With the asynchronous transmit, the queued writes are transmitted first.
+ *
+ * @param  delay Execution time in ms.
+ */
+static void LCD_Delay(uint32_t delay);
+
+/**
+ * @brief  Waits until the LCD has executed an instruction.
+ *
+ * Only the instructions longer than the transmit of the next packet are waited for. With
+ * LCD_BUSY_FLAG_READ, the busy flag is polled up to LCD_TIMEOUT, otherwise the execution time
+ * of the instruction is waited.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  cmd The instruction sent to the LCD.
+ * @return e_Status Returns STATUS_OK if executed, STATUS_TIMEOUT if the LCD stayed busy.
+ */
+static e_Status LCD_WaitExecution(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Sends a command to the LCD and waits for its execution.
+ *
+ * @param  lcd Context of the LCD.
  * @param  cmd The command byte to be sent.
+ * @return e_Status Returns the status of the transmission or of the execution.
+ */
+static e_Status LCD_CommandWriteWait(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Sends the high nibble of a command to the LCD with a single enable pulse.
+ *
+ * Used for the function sets of the initialization, while the LCD is still in 8-bit mode.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  cmd The command byte, only the high nibble is sent.
+ * @return e_Status Returns the status of the transmission.
+ */
+static e_Status LCD_NibbleWrite(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Forgets the cached controls if a transmit was dropped since the last check.
+ *
+ * @param  lcd Context of the LCD.
+ */
+static void LCD_StateCheckDrop(st_LCDHandle *lcd);
+
+/**
+ * @brief  Caches a display on/off control or entry mode set command.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  cmd The command to be sent.
+ * @return uint8_t 1 if the LCD is already in the state of the command (not to be sent), 0 otherwise.
+ */
+static uint8_t LCD_CacheControl(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Sends a display on/off control or entry mode set command, unless already in the state.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  cmd The command.
+ * @return e_Status Returns the status of the transmission, STATUS_OK if skipped.
+ */
+static e_Status LCD_ControlWrite(st_LCDHandle *lcd, uint8_t cmd);
+
+/**
+ * @brief  Sets the backlight, unless already in the state.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  backlight LCD_BACKLIGHT_ON or 0.
+ * @return e_Status Returns the status of the transmission, STATUS_OK if skipped.
+ */
+static e_Status LCD_SetBacklight(st_LCDHandle *lcd, uint8_t backlight);
+
+/**
+ * @brief  Sends the backlight pin alone, in one byte.
+ *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission.
+ */
+static e_Status LCD_BacklightWrite(st_LCDHandle *lcd);
+
+#if(LCD_BUSY_FLAG_READ == 1u)
+/**
+ * @brief  Reads the busy flag of the LCD.
+ *
+ * The data pins are released on the PCF8574 and the high nibble is read with R/W high.
+ * The low nibble (address counter) is clocked out to keep the 4-bit transfers aligned.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  busyFlag Pointer to store 1 if the LCD is busy, 0 otherwise.
+ * @return e_Status Returns the status of the transmission.
+ */
+static e_Status LCD_ReadBusyFlag(st_LCDHandle *lcd, uint8_t *busyFlag);
+#endif
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+/**
+ * @brief  Copies data in the transmit queue and starts the transmit.
+ *
+ * Waits for room in the queue, up to LCD_TIMEOUT. The data follow the last segment if it is
+ * for the same LCD and stays within LCD_BATCH_MAX_SIZE, otherwise a segment is added.
+ *
+ * @param  lcd Context of the LCD the data are transmitted to.
+ * @param  data Pointer to the data.
+ * @param  size The size of the data.
+ * @return e_Status Returns STATUS_OK if queued, STATUS_TIMEOUT if the queue stayed full.
+ */
+static e_Status LCD_QueuePush(st_LCDHandle *lcd, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Starts the transmit of the next part of the queue if the bus is idle.
+ *
+ * A transmit never crosses a segment, it goes to the LCD of the segment.
+ * Called with the interrupts masked or from the interrupt.
+ */
+static void LCD_QueueStart();
+
+/**
+ * @brief  Waits until the transmit queue is empty, up to LCD_TIMEOUT.
+ *
+ * @return e_Status Returns STATUS_OK if empty, STATUS_TIMEOUT otherwise.
+ */
+static e_Status LCD_QueueWaitEmpty();
+
+/**
+ * @brief  Moves the empty queue back to the start of its buffer.
+ *
+ * The next LCD_TRANSFER_MAX_SIZE bytes are contiguous and sent in one transmit.
+ */
+static void LCD_QueueRewind();
+#endif
+
+/**
+ * @brief  Sets the content of the LCD, as known by the framebuffer.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  valid 1 if the LCD is blank, 0 if the content is unknown.
+ */
+static void LCD_SetShadow(st_LCDHandle *lcd, uint8_t valid);
+
+/**
+ * @brief  Checks if a cell of the framebuffer differs from the LCD.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position.
+ * @param  colPos The column position.
+ * @return uint8_t 1 if the cell is dirty, 0 otherwise.
+ */
+static uint8_t LCD_IsCellDirty(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos);
+
+/**
+ * @brief  Sends the changed cells of a framebuffer row to the LCD.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position.
+ * @return e_Status Returns the status of the transmission.
+ */
+static e_Status LCD_FlushRow(st_LCDHandle *lcd, uint8_t rowPos);
+
+/**
+ * @brief  Empties CGRAM slots, their content is unknown.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  slots The slots to empty, one bit per slot, LCD_SLOTS_ALL for the whole CGRAM.
+ */
+static void LCD_ResetGlyphSlots(st_LCDHandle *lcd, uint8_t slots);
+
+/**
+ * @brief  Finds a slot for a glyph not in the CGRAM.
+ *
+ * An empty slot is used first, then the least recently used one. The slots of the glyphs
+ * on the LCD (shadow of the framebuffer, direct writes included) or to be displayed by the
+ * framebuffer are not replaced.
+ *
+ * @param  lcd Context of the LCD.
+ * @return uint8_t The slot, LCD_CGRAM_SLOTS if every slot is displayed.
+ */
+static uint8_t LCD_GetReplaceSlot(st_LCDHandle *lcd);
+
+/**
+ * @brief  Gets the character code of a glyph, the glyph is added to the batch if not in the CGRAM.
+ *
+ * The DDRAM address is set again after the glyph, the cursor is kept.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  glyphId The glyph ID.
+ * @param  charCode Pointer to store the character code of the glyph.
+ * @return e_Status Returns the status of the transmission, STATUS_NOT_OK if the glyph is not
+ *         registered, STATUS_BUSY if every slot is displayed.
+ */
+static e_Status LCD_ResolveGlyph(st_LCDHandle *lcd, uint8_t glyphId, uint8_t *charCode);
+
+/**
+ * @brief  Scrolls the marquee by one column.
+ *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_CommandWrite(uint8_t cmd);
+static e_Status LCD_MarqueeStep(st_LCDHandle *lcd);
+
+/**
+ * @brief  Adds a formatted character to the batch.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  character The character.
+ * @return e_Status Returns the status of the transmission of the full batch.
+ */
+static e_Status LCD_PutDisplay(st_LCDHandle *lcd, uint8_t character);
+
+/**
+ * @brief  Writes a formatted character in the framebuffer, at printRow and printCol.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  character The character, dropped at the end of the row.
+ * @return e_Status Returns STATUS_OK.
+ */
+static e_Status LCD_PutFrame(st_LCDHandle *lcd, uint8_t character);
+
+/**
+ * @brief  Outputs a character several times.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  putChar The output of the characters.
+ * @param  character The character.
+ * @param  count The number of characters.
+ * @return e_Status Returns the status of the output.
+ */
+static e_Status LCD_FormatPad(st_LCDHandle *lcd, pf_PutChar putChar, uint8_t character, uint8_t count);
+
+/**
+ * @brief  Outputs a number, with its sign, decimal point and padding.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  putChar The output of the characters.
+ * @param  magnitude The absolute value of the number.
+ * @param  negative 1 if the number is negative.
+ * @param  spec The conversion.
+ * @return e_Status Returns the status of the output.
+ */
+static e_Status LCD_FormatNumber(st_LCDHandle *lcd, pf_PutChar putChar, uint32_t magnitude, uint8_t negative, const st_FormatSpec *spec);
+
+/**
+ * @brief  Outputs a string, cut at the precision and padded to the width.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  putChar The output of the characters.
+ * @param  stringData The string.
+ * @param  spec The conversion.
+ * @return e_Status Returns the status of the output.
+ */
+static e_Status LCD_FormatString(st_LCDHandle *lcd, pf_PutChar putChar, const char *stringData, const st_FormatSpec *spec);
+
+/**
+ * @brief  Formats the arguments (see LCD_Printf()).
+ *
+ * @param  lcd Context of the LCD.
+ * @param  putChar The output of the characters.
+ * @param  format The format string.
+ * @param  args The arguments.
+ * @return e_Status Returns the status of the output.
+ */
+static e_Status LCD_Format(st_LCDHandle *lcd, pf_PutChar putChar, const char *format, va_list args);
+
+
+/* Static Function Definition -------------------------*/
+
+e_Status LCD_CommandWrite(st_LCDHandle *lcd, uint8_t cmd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	/* Sent right away, after anything already in the batch */
+	returnValue = LCD_BatchAppend(lcd, cmd, 0u);
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_BatchSend();
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_DataWrite(st_LCDHandle *lcd, uint8_t data)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	/* Sent right away, after anything already in the batch */
+	returnValue = LCD_BatchAppend(lcd, data, LCD_SEND_DATA);
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_BatchSend();
+	}
+
+	return returnValue;
+}
+
+static void LCD_EncodePacket(uint8_t value, uint8_t modeBits, uint8_t backlight, uint8_t *packet)
+{
+	uint8_t dataMSB = 0u;  /* Most significant nibble of command/data */
+	uint8_t dataLSB = 0u;  /* Least significant nibble of command/data */
+
+	dataMSB = value & 0xF0;  /* Extract the most significant nibble */
+	dataLSB = (value << 4u) & 0xF0;  /* Extract the least significant nibble */
+
+	/* Set backlight, command/data, and enable high for MSB data packet */
+	dataMSB |= backlight | modeBits | LCD_ENABLE_HIGH;
+	packet[0u] = dataMSB;
+
+	/* Set enable low */
+	dataMSB &= LCD_ENABLE_LOW;
+	packet[1u] = dataMSB;
+
+	/* Set backlight, command/data, and enable high for LSB data packet */
+	dataLSB |= backlight | modeBits | LCD_ENABLE_HIGH;
+	packet[2u] = dataLSB;
+
+	/* Set enable low */
+	dataLSB &= LCD_ENABLE_LOW;
+	packet[3u] = dataLSB;
+}
+
+static e_Status LCD_BatchAppend(st_LCDHandle *lcd, uint8_t value, uint8_t modeBits)
+{
+	e_Status returnValue = STATUS_OK;
+
+	/* Chunk the batch at batchLimit, one batch is for one LCD */
+	if( (batchHandle != lcd) || ((batchLength + LCD_PACKET_SZ) > batchLimit) )
+	{
+		returnValue = LCD_BatchSend();
+		batchHandle = lcd;
+	}
+
+	LCD_EncodePacket(value, modeBits, lcd->backlight, &batchBuffer[batchLength]);
+	batchLength += LCD_PACKET_SZ;
+	LCD_TrackAddress(lcd, value, modeBits);
+
+	return returnValue;
+}
+
+static e_Status LCD_BatchSend()
+{
+	e_Status returnValue = STATUS_OK;
+
+	if(batchLength != 0u)
+	{
+		returnValue = LCD_PortWrite(batchHandle, batchBuffer, batchLength);
+		if(returnValue != STATUS_OK)
+		{
+			/* The glyphs written by the failed transmit may not be in the CGRAM */
+			LCD_ResetGlyphSlots(batchHandle, batchSlots);
+		}
+		batchLength = 0u;
+	}
+
+	batchSlots = 0u;
+
+	return returnValue;
+}
+
+static void LCD_BatchDiscard()
+{
+	/* The shadow already holds the characters of the batch, the glyph cache its CGRAM writes */
+	if(batchLength != 0u)
+	{
+		LCD_SetShadow(batchHandle, 0u);
+		LCD_ResetGlyphSlots(batchHandle, batchSlots);
+		batchLength = 0u;
+	}
+
+	batchSlots = 0u;
+}
+
+static e_Status LCD_PortWrite(st_LCDHandle *lcd, const uint8_t *data, uint16_t size)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	/* Counted when the transmit starts */
+	returnValue = LCD_QueuePush(lcd, data, size);
+#else
+	returnValue = LCD_Transmit(lcd->i2cHandle, lcd->deviceAddress, (uint8_t*)data, size);
+	lcd->transactions.transmitCount++;
+	lcd->transactions.byteCount += size;
+#endif
+
+	if(returnValue != STATUS_OK)
+	{
+		/* The shadow holds the characters of the failed transmit */
+		LCD_SetShadow(lcd, 0u);
+	}
+
+	return returnValue;
+}
+
+static void LCD_TrackAddress(st_LCDHandle *lcd, uint8_t value, uint8_t modeBits)
+{
+	if(modeBits == LCD_SEND_DATA)
+	{
+		/* The address follows the entry mode, from the end of line 1 to line 2 and back */
+		if(lcd->cgramSelected == 0u)
+		{
+			LCD_ShadowWrite(lcd, lcd->addressCounter, value);
+
+			if( (lcd->entryMode & LCD_INCREMENT) == 0u )
+			{
+				if(lcd->addressCounter == LCD_ROW_0)
+				{
+					lcd->addressCounter = LCD_ROW_1 + LCD_LINE_LENGTH - 1u;
+				}
+				else if(lcd->addressCounter == LCD_ROW_1)
+				{
+					lcd->addressCounter = LCD_ROW_0 + LCD_LINE_LENGTH - 1u;
+				}
+				else
+				{
+					lcd->addressCounter--;
+				}
+			}
+			else if(lcd->addressCounter == (LCD_ROW_0 + LCD_LINE_LENGTH - 1u))
+			{
+				lcd->addressCounter = LCD_ROW_1;
+			}
+			else if(lcd->addressCounter == (LCD_ROW_1 + LCD_LINE_LENGTH - 1u))
+			{
+				lcd->addressCounter = LCD_ROW_0;
+			}
+			else
+			{
+				lcd->addressCounter++;
+			}
+		}
+	}
+	else if( (value & LCD_SET_DDRAM_ADDR) == LCD_SET_DDRAM_ADDR )
+	{
+		lcd->addressCounter = value & ~LCD_SET_DDRAM_ADDR;
+		lcd->cgramSelected = 0u;
+	}
+	else if( (value & LCD_SET_CGRAM_ADDR) == LCD_SET_CGRAM_ADDR )
+	{
+		lcd->cgramSelected = 1u;
+	}
+	else if( (value == LCD_CLEAR_DISPLAY) || ((value & 0xFE) == LCD_RET_HOME) )
+	{
+		lcd->addressCounter = LCD_ROW_0;
+		lcd->cgramSelected = 0u;
+
+		/* The clear fills the DDRAM with blanks */
+		if(value == LCD_CLEAR_DISPLAY)
+		{
+			LCD_SetShadow(lcd, 1u);
+		}
+	}
+	else
+	{
+		/* The other instructions keep the address */
+	}
+}
+
+static void LCD_ShadowWrite(st_LCDHandle *lcd, uint8_t address, uint8_t character)
+{
+	for(uint8_t row = 0u; row < lcd->rowCount; row++)
+	{
+		if( (address >= lcd->rowOffset[row]) && ((uint8_t)(address - lcd->rowOffset[row]) < lcd->charCount) )
+		{
+			lcd->frame.shadowBuffer[row][address - lcd->rowOffset[row]] = character;
+			lcd->frame.shadowValid[row][address - lcd->rowOffset[row]] = 1u;
+		}
+	}
+}
+
+static e_Status LCD_GetCursorCommand(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, uint8_t *cursorCmd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	/* Check if the row and column input are withine range */
+	if(rowPos < lcd->rowCount && colPos < lcd->charCount)
+	{
+		*cursorCmd = (uint8_t)(lcd->rowOffset[rowPos] + colPos) | LCD_SET_DDRAM_ADDR;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+static void LCD_Delay(uint32_t delay)
+{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	/* The execution time starts once the command is on the bus */
+	(void)LCD_QueueWaitEmpty();
+#endif
+	COMMON_DELAY(delay);
+}
+
+static e_Status LCD_WaitExecution(st_LCDHandle *lcd, uint8_t cmd)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t index = 0u;
+#if(LCD_BUSY_FLAG_READ == 1u)
+	uint8_t busyFlag = 1u;
+	uint32_t waitStart = COMMON_GET_TICK();
+#else
+	(void)lcd;
+#endif
+
+	/* Index of the highest set bit, the instruction code */
+	while( (cmd >> (index + 1u)) != 0u )
+	{
+		index++;
+	}
+
+	/* Short instructions are executed before the next packet is on the bus */
+	if(executionTime[index] > LCD_EXEC_TIME_COVERED)
+	{
+#if(LCD_BUSY_FLAG_READ == 1u)
+		while( (busyFlag == 1u) && (returnValue == STATUS_OK) )
+		{
+			returnValue = LCD_ReadBusyFlag(lcd, &busyFlag);
+
+			if( (busyFlag == 1u) && ((uint32_t)(COMMON_GET_TICK() - waitStart) > LCD_TIMEOUT) )
+			{
+				returnValue = STATUS_TIMEOUT;
+			}
+		}
+#else
+		/* Round up to the ms */
+		LCD_Delay( ((uint32_t)executionTime[index] + 999u) / 1000u );
+#endif
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_CommandWriteWait(st_LCDHandle *lcd, uint8_t cmd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	returnValue = LCD_CommandWrite(lcd, cmd);
+
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_WaitExecution(lcd, cmd);
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_NibbleWrite(st_LCDHandle *lcd, uint8_t cmd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t sendPacket[2u] = {0x00};
+
+	/* Send what is pending first, to keep the order */
+	returnValue = LCD_BatchSend();
+
+	if(returnValue == STATUS_OK)
+	{
+		sendPacket[0u] = (cmd & 0xF0) | lcd->backlight | LCD_ENABLE_HIGH;
+		sendPacket[1u] = sendPacket[0u] & LCD_ENABLE_LOW;
+		returnValue = LCD_PortWrite(lcd, sendPacket, 2u);
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_BacklightWrite(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t portByte = lcd->backlight; /* Enable low, the LCD ignores the data pins */
+
+	/* Send what is pending first, to keep the order */
+	returnValue = LCD_BatchSend();
+
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_PortWrite(lcd, &portByte, 1u);
+	}
+
+	return returnValue;
+}
+
+static void LCD_StateCheckDrop(st_LCDHandle *lcd)
+{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	/* The commands of a dropped transmit may not have reached the LCD */
+	if(lcd->stateDropCount != queueDropCount)
+	{
+		lcd->stateDropCount = queueDropCount;
+		lcd->stateValid = 0u;
+	}
+#else
+	(void)lcd;
+#endif
+}
+
+static uint8_t LCD_CacheControl(st_LCDHandle *lcd, uint8_t cmd)
+{
+	uint8_t isCached = 0u;
+
+	LCD_StateCheckDrop(lcd);
+
+	if( (cmd & 0xF8) == LCD_DISPLAY_CONTROL )
+	{
+		isCached = ( ((lcd->stateValid & LCD_STATE_DISPLAY) != 0u) && (lcd->displayControl == cmd) ) ? 1u : 0u;
+		lcd->displayControl = cmd;
+		lcd->stateValid |= LCD_STATE_DISPLAY;
+	}
+	else if( (cmd & 0xFC) == LCD_ENTRY_MODE_SET )
+	{
+		isCached = ( ((lcd->stateValid & LCD_STATE_ENTRY_MODE) != 0u) && (lcd->entryMode == cmd) ) ? 1u : 0u;
+		lcd->entryMode = cmd;
+		lcd->stateValid |= LCD_STATE_ENTRY_MODE;
+	}
+	else if(cmd == LCD_CLEAR_DISPLAY)
+	{
+		/* The clear also sets the increment */
+		lcd->entryMode |= LCD_INCREMENT;
+	}
+	else
+	{
+		/* The other instructions are not cached */
+	}
+
+	if(isCached == 1u)
+	{
+		lcd->transactions.elidedCount++;
+	}
+
+	return isCached;
+}
+
+static e_Status LCD_ControlWrite(st_LCDHandle *lcd, uint8_t cmd)
+{
+	e_Status returnValue = STATUS_OK;
+
+	if(LCD_CacheControl(lcd, cmd) == 0u)
+	{
+		returnValue = LCD_CommandWrite(lcd, cmd);
+		if(returnValue != STATUS_OK)
+		{
+			/* The state of the LCD is unknown */
+			lcd->stateValid = 0u;
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_SetBacklight(st_LCDHandle *lcd, uint8_t backlight)
+{
+	e_Status returnValue = STATUS_OK;
+
+	LCD_StateCheckDrop(lcd);
+
+	if( ((lcd->stateValid & LCD_STATE_BACKLIGHT) != 0u) && (lcd->backlight == backlight) )
+	{
+		lcd->transactions.elidedCount++;
+	}
+	else
+	{
+		lcd->backlight = backlight;
+		returnValue = LCD_BacklightWrite(lcd);
+		if(returnValue == STATUS_OK)
+		{
+			lcd->stateValid |= LCD_STATE_BACKLIGHT;
+		}
+		else
+		{
+			lcd->stateValid &= (uint8_t)~LCD_STATE_BACKLIGHT;
+		}
+	}
+
+	return returnValue;
+}
+
+#if(LCD_BUSY_FLAG_READ == 1u)
+static e_Status LCD_ReadBusyFlag(st_LCDHandle *lcd, uint8_t *busyFlag)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t sendPacket[3u] = {0x00};
+	uint8_t readByte = LCD_BUSY_FLAG;
+
+	/* Release the data pins, read the instruction register, enable high */
+	sendPacket[0u] = LCD_DATA_RELEASE | lcd->backlight | LCD_READ | LCD_ENABLE_HIGH;
+	returnValue = LCD_PortWrite(lcd, sendPacket, 1u);
+
+	/* The busy flag is on D7 while enable is high */
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_Receive(lcd->i2cHandle, lcd->deviceAddress, &readByte, 1u);
+	}
+
+	/* Enable low, then clock out the low nibble */
+	if(returnValue == STATUS_OK)
+	{
+		sendPacket[0u] = LCD_DATA_RELEASE | lcd->backlight | LCD_READ;
+		sendPacket[1u] = sendPacket[0u] | LCD_ENABLE_HIGH;
+		sendPacket[2u] = sendPacket[0u];
+		returnValue = LCD_PortWrite(lcd, sendPacket, 3u);
+	}
+
+	*busyFlag = ((readByte & LCD_BUSY_FLAG) == LCD_BUSY_FLAG) ? 1u : 0u;
+
+	return returnValue;
+}
+#endif
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+static e_Status LCD_QueuePush(st_LCDHandle *lcd, const uint8_t *data, uint16_t size)
+{
+	e_Status returnValue = STATUS_OK;
+	uint32_t waitStart = COMMON_GET_TICK();
+	uint32_t interruptState = 0u;
+	uint16_t head = queueHead;
+	uint8_t lastSegment = (uint8_t)(segmentHead - 1u) & (LCD_QUEUE_SEGMENTS - 1u);
+
+	/* Wait for room and for a segment, the queue drains from the transmit complete interrupt */
+	while( (((uint16_t)(LCD_QUEUE_SIZE - (uint16_t)(head - queueTail)) < size) ||
+			((uint8_t)(segmentHead - segmentTail) == LCD_QUEUE_SEGMENTS)) && (returnValue == STATUS_OK) )
+	{
+		if( (uint32_t)(COMMON_GET_TICK() - waitStart) > LCD_TIMEOUT )
+		{
+			returnValue = STATUS_TIMEOUT;
+		}
+	}
+
+	if(returnValue == STATUS_OK)
+	{
+		for(uint16_t i = 0u; i < size; i++)
+		{
+			transmitQueue[(uint16_t)(head + i) & (LCD_QUEUE_SIZE - 1u)] = data[i];
+		}
+
+		/* The data must be in the queue before the interrupt can see it */
+		COMMON_MEMORY_BARRIER();
+
+		COMMON_ENTER_CRITICAL(interruptState);
+		/* Back-to-back writes to one LCD are transmitted together, a later segment keeps the order */
+		if( (segmentHead != segmentTail) && (segmentHandle[lastSegment] == lcd) &&
+			((segmentLength[lastSegment] + size) <= LCD_BATCH_MAX_SIZE) )
+		{
+			segmentLength[lastSegment] += size;
+		}
+		else
+		{
+			segmentHandle[segmentHead & (LCD_QUEUE_SEGMENTS - 1u)] = lcd;
+			segmentLength[segmentHead & (LCD_QUEUE_SEGMENTS - 1u)] = size;
+			segmentHead = segmentHead + 1u;
+		}
+		queueHead = head + size;
+
+		LCD_QueueStart();
+		COMMON_EXIT_CRITICAL(interruptState);
+	}
+
+	return returnValue;
+}
+
+static void LCD_QueueStart()
+{
+	uint16_t tail = queueTail;
+	uint8_t segment = segmentTail & (LCD_QUEUE_SEGMENTS - 1u);
+	uint16_t queuedSize = 0u;
+	uint16_t contiguousSize = LCD_QUEUE_SIZE - (tail & (LCD_QUEUE_SIZE - 1u));
+	st_LCDHandle *lcd = segmentHandle[segment];
+
+	if( (transferLength == 0u) && (segmentHead != segmentTail) )
+	{
+		/* One transmit up to the end of the segment or of the queue buffer, chunked like the batches */
+		queuedSize = segmentLength[segment] - segmentSent;
+		if(queuedSize > contiguousSize)
+		{
+			queuedSize = contiguousSize;
+		}
+		if(queuedSize > LCD_TRANSFER_MAX_SIZE)
+		{
+			queuedSize = LCD_TRANSFER_MAX_SIZE;
+		}
+
+		transferLength = queuedSize;
+		lcd->transactions.transmitCount++;
+		lcd->transactions.byteCount += queuedSize;
+		if(LCD_TransmitAsync(lcd->i2cHandle, lcd->deviceAddress, &transmitQueue[tail & (LCD_QUEUE_SIZE - 1u)], queuedSize) != STATUS_OK)
+		{
+			LCD_TransmitErrorCallback();
+		}
+	}
+}
+
+static e_Status LCD_QueueWaitEmpty()
+{
+	e_Status returnValue = STATUS_OK;
+	uint32_t waitStart = COMMON_GET_TICK();
+
+	while( ((queueHead != queueTail) || (transferLength != 0u)) && (returnValue == STATUS_OK) )
+	{
+		if( (uint32_t)(COMMON_GET_TICK() - waitStart) > LCD_TIMEOUT )
+		{
+			returnValue = STATUS_TIMEOUT;
+		}
+	}
+
+	return returnValue;
+}
+
+static void LCD_QueueRewind()
+{
+	uint32_t interruptState = 0u;
+
+	COMMON_ENTER_CRITICAL(interruptState);
+	if( (queueHead == queueTail) && (transferLength == 0u) )
+	{
+		queueHead = 0u;
+		queueTail = 0u;
+	}
+	COMMON_EXIT_CRITICAL(interruptState);
+}
+#endif
+
+static void LCD_SetShadow(st_LCDHandle *lcd, uint8_t valid)
+{
+	for(uint8_t row = 0u; row < LCD_ROW_MAX; row++)
+	{
+		for(uint8_t col = 0u; col < LCD_CHAR_MAX; col++)
+		{
+			lcd->frame.shadowBuffer[row][col] = LCD_BLANK_CHAR;
+			lcd->frame.shadowValid[row][col] = valid;
+		}
+	}
+}
+
+static uint8_t LCD_IsCellDirty(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos)
+{
+	return ( (lcd->frame.shadowValid[rowPos][colPos] == 0u) ||
+			 (lcd->frame.shadowBuffer[rowPos][colPos] != lcd->frame.frameBuffer[rowPos][colPos]) ) ? 1u : 0u;
+}
+
+static e_Status LCD_FlushRow(st_LCDHandle *lcd, uint8_t rowPos)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t cursorCol = lcd->charCount; /* charCount when the cursor is not in the row */
+	uint8_t cursorCmd = 0x00;
+	uint8_t col = 0u;
+
+	for(col = 0u; (col < lcd->charCount) && (returnValue == STATUS_OK); col++)
+	{
+		if(LCD_IsCellDirty(lcd, rowPos, col) == 1u)
+		{
+			/* Move the cursor unless the gap is cheaper to write through */
+			if( (cursorCol > col) || ((uint8_t)(col - cursorCol) > LCD_WRITE_THROUGH_CELLS) )
+			{
+				returnValue = LCD_GetCursorCommand(lcd, rowPos, col, &cursorCmd);
+				if(returnValue == STATUS_OK)
+				{
+					returnValue = LCD_BatchAppend(lcd, cursorCmd, 0u);
+				}
+				cursorCol = col;
+			}
+
+			/* Write the gap and the dirty cell, the LCD increments the cursor and the shadow follows */
+			while( (cursorCol <= col) && (returnValue == STATUS_OK) )
+			{
+				returnValue = LCD_BatchAppend(lcd, lcd->frame.frameBuffer[rowPos][cursorCol], LCD_SEND_DATA);
+				cursorCol++;
+			}
+		}
+	}
+
+	return returnValue;
+}
+
+static void LCD_ResetGlyphSlots(st_LCDHandle *lcd, uint8_t slots)
+{
+	for(uint8_t slot = 0u; slot < LCD_CGRAM_SLOTS; slot++)
+	{
+		if( (slots & (1u << slot)) != 0u )
+		{
+			lcd->glyphCache.slotGlyph[slot] = LCD_GLYPH_NONE;
+			lcd->glyphCache.slotVersion[slot] = 0u;
+			lcd->glyphCache.slotLastUse[slot] = 0u;
+		}
+	}
+}
+
+static uint8_t LCD_GetReplaceSlot(st_LCDHandle *lcd)
+{
+	uint8_t displayedSlots = 0u; /* One bit per slot on the LCD or in the framebuffer */
+	uint8_t replaceSlot = LCD_CGRAM_SLOTS;
+
+	for(uint8_t row = 0u; row < lcd->rowCount; row++)
+	{
+		for(uint8_t col = 0u; col < lcd->charCount; col++)
+		{
+			if(lcd->frame.frameBuffer[row][col] < LCD_CGRAM_SLOTS)
+			{
+				displayedSlots |= (uint8_t)(1u << lcd->frame.frameBuffer[row][col]);
+			}
+
+			/* A glyph on the LCD changes as soon as its slot is written, before the next flush */
+			if( (lcd->frame.shadowValid[row][col] == 1u) && (lcd->frame.shadowBuffer[row][col] < LCD_CGRAM_SLOTS) )
+			{
+				displayedSlots |= (uint8_t)(1u << lcd->frame.shadowBuffer[row][col]);
+			}
+		}
+	}
+
+	/* The empty slots were never used, they are the least recently used */
+	for(uint8_t slot = 0u; slot < LCD_CGRAM_SLOTS; slot++)
+	{
+		if( ((displayedSlots & (1u << slot)) == 0u) &&
+			((replaceSlot == LCD_CGRAM_SLOTS) || (lcd->glyphCache.slotLastUse[slot] < lcd->glyphCache.slotLastUse[replaceSlot])) )
+		{
+			replaceSlot = slot;
+		}
+	}
+
+	return replaceSlot;
+}
+
+static e_Status LCD_ResolveGlyph(st_LCDHandle *lcd, uint8_t glyphId, uint8_t *charCode)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	st_LCDGlyphCache *glyphCache = &lcd->glyphCache;
+	uint8_t slot = 0u;
+	uint8_t ddramAddress = lcd->addressCounter;
+	uint8_t restoreAddress = (lcd->cgramSelected == 0u) ? 1u : 0u;
+
+	if( (glyphId < LCD_GLYPH_MAX) && (glyphTable[glyphId] != NULL) )
+	{
+		glyphCache->useCount++;
+
+		/* A slot loaded before the glyph was registered again is outdated */
+		while( (slot < LCD_CGRAM_SLOTS) &&
+			   ((glyphCache->slotGlyph[slot] != glyphId) || (glyphCache->slotVersion[slot] != glyphVersion[glyphId])) )
+		{
+			slot++;
+		}
+
+		if(slot < LCD_CGRAM_SLOTS)
+		{
+			/* Already in the CGRAM */
+			glyphCache->statistics.hitCount++;
+			returnValue = STATUS_OK;
+		}
+		else
+		{
+			slot = LCD_GetReplaceSlot(lcd);
+			if(slot < LCD_CGRAM_SLOTS)
+			{
+				/* Content of the slot unknown until the glyph is written */
+				glyphCache->slotGlyph[slot] = LCD_GLYPH_NONE;
+				returnValue = LCD_BatchAppend(lcd, LCD_SET_CGRAM_ADDR | (uint8_t)(slot * LCD_GLYPH_ROWS), 0u);
+				for(uint8_t i = 0u; (i < LCD_GLYPH_ROWS) && (returnValue == STATUS_OK); i++)
+				{
+					returnValue = LCD_BatchAppend(lcd, glyphTable[glyphId][i], LCD_SEND_DATA);
+				}
+
+				/* Back to the DDRAM, at the cursor position */
+				if( (returnValue == STATUS_OK) && (restoreAddress == 1u) )
+				{
+					returnValue = LCD_BatchAppend(lcd, LCD_SET_DDRAM_ADDR | ddramAddress, 0u);
+				}
+
+				if(returnValue == STATUS_OK)
+				{
+					/* Forgotten if the batch is not transmitted */
+					batchSlots |= (uint8_t)(1u << slot);
+					glyphCache->slotGlyph[slot] = glyphId;
+					glyphCache->slotVersion[slot] = glyphVersion[glyphId];
+					glyphCache->statistics.uploadCount++;
+					glyphCache->statistics.cgramWriteCount += LCD_GLYPH_ROWS;
+				}
+			}
+			else
+			{
+				returnValue = STATUS_BUSY;
+			}
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			glyphCache->slotLastUse[slot] = glyphCache->useCount;
+			*charCode = slot;
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_MarqueeStep(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	st_LCDMarquee *marquee = &lcd->marquee;
+	uint8_t cellCmd = 0x00;
+	uint8_t leftCell = marquee->offset; /* Hidden by the shift */
+
+	returnValue = LCD_BatchAppend(lcd, LCD_MARQUEE_STEP, 0u);
+	marquee->offset = (uint8_t)((marquee->offset + 1u) % LCD_LINE_LENGTH);
+
+	/* The hidden cell shows the next characters of a long text, LCD_LINE_LENGTH steps later */
+	for(uint8_t row = 0u; (row < lcd->rowCount) && (returnValue == STATUS_OK); row++)
+	{
+		if(marquee->size[row] > LCD_LINE_LENGTH)
+		{
+			returnValue = LCD_GetCursorCommand(lcd, row, 0u, &cellCmd);
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = LCD_BatchAppend(lcd, cellCmd + leftCell, 0u);
+			}
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = LCD_BatchAppend(lcd, (uint8_t)marquee->text[row][marquee->textIndex[row]], LCD_SEND_DATA);
+			}
+			marquee->textIndex[row] = (uint8_t)((marquee->textIndex[row] + 1u) % marquee->size[row]);
+		}
+	}
+
+	marquee->statistics.stepCount++;
+	marquee->statistics.byteCount += batchLength;
+	if(returnValue == STATUS_OK)
+	{
+		marquee->statistics.transmitCount++;
+		returnValue = LCD_BatchSend();
+	}
+	else
+	{
+		LCD_BatchDiscard();
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_PutDisplay(st_LCDHandle *lcd, uint8_t character)
+{
+	return LCD_BatchAppend(lcd, character, LCD_SEND_DATA);
+}
+
+static e_Status LCD_PutFrame(st_LCDHandle *lcd, uint8_t character)
+{
+	if(lcd->frame.printCol < lcd->charCount)
+	{
+		lcd->frame.frameBuffer[lcd->frame.printRow][lcd->frame.printCol] = character;
+		lcd->frame.printCol++;
+	}
+	else
+	{
+		/* Clipped at the end of the row */
+	}
+
+	return STATUS_OK;
+}
+
+static e_Status LCD_FormatPad(st_LCDHandle *lcd, pf_PutChar putChar, uint8_t character, uint8_t count)
+{
+	e_Status returnValue = STATUS_OK;
+
+	for(uint8_t i = 0u; (i < count) && (returnValue == STATUS_OK); i++)
+	{
+		returnValue = putChar(lcd, character);
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_FormatNumber(st_LCDHandle *lcd, pf_PutChar putChar, uint32_t magnitude, uint8_t negative, const st_FormatSpec *spec)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t digits[LCD_FORMAT_DIGITS_SIZE]; /* In reverse order */
+	uint8_t digitCount = 0u;
+	uint8_t digit = 0u;
+	uint8_t sign = 0u;
+	uint8_t length = 0u;
+	uint8_t padCount = 0u;
+
+	if(negative == 1u)
+	{
+		sign = '-';
+	}
+	else if( (spec->flags & LCD_FORMAT_PLUS) == LCD_FORMAT_PLUS )
+	{
+		sign = '+';
+	}
+	else
+	{
+		/* No sign */
+	}
+
+	/* At least one digit before the decimal point */
+	do
+	{
+		if( (digitCount == spec->decimals) && (spec->decimals != 0u) )
+		{
+			digits[digitCount] = '.';
+			digitCount++;
+		}
+
+		digit = (uint8_t)(magnitude % spec->base);
+		magnitude /= spec->base;
+		if(digit < 10u)
+		{
+			digits[digitCount] = '0' + digit;
+		}
+		else
+		{
+			digits[digitCount] = ( ((spec->flags & LCD_FORMAT_UPPER) == LCD_FORMAT_UPPER) ? 'A' : 'a' ) + (digit - 10u);
+		}
+		digitCount++;
+	}
+	while( (magnitude != 0u) || (digitCount <= spec->decimals) );
+
+	length = digitCount + ((sign != 0u) ? 1u : 0u);
+	padCount = (spec->width > length) ? (uint8_t)(spec->width - length) : 0u;
+
+	if( (spec->flags & (LCD_FORMAT_LEFT | LCD_FORMAT_ZERO)) == 0u )
+	{
+		returnValue = LCD_FormatPad(lcd, putChar, ' ', padCount);
+	}
+
+	if( (sign != 0u) && (returnValue == STATUS_OK) )
+	{
+		returnValue = putChar(lcd, sign);
+	}
+
+	/* Zeros between the sign and the digits */
+	if( ((spec->flags & (LCD_FORMAT_LEFT | LCD_FORMAT_ZERO)) == LCD_FORMAT_ZERO) && (returnValue == STATUS_OK) )
+	{
+		returnValue = LCD_FormatPad(lcd, putChar, '0', padCount);
+	}
+
+	while( (digitCount != 0u) && (returnValue == STATUS_OK) )
+	{
+		digitCount--;
+		returnValue = putChar(lcd, digits[digitCount]);
+	}
+
+	if( ((spec->flags & LCD_FORMAT_LEFT) == LCD_FORMAT_LEFT) && (returnValue == STATUS_OK) )
+	{
+		returnValue = LCD_FormatPad(lcd, putChar, ' ', padCount);
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_FormatString(st_LCDHandle *lcd, pf_PutChar putChar, const char *stringData, const st_FormatSpec *spec)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t length = 0u;
+	uint8_t padCount = 0u;
+
+	while( (stringData[length] != '\0') && (length < spec->precision) && (length < LCD_FORMAT_WIDTH_MAX) )
+	{
+		length++;
+	}
+	padCount = (spec->width > length) ? (uint8_t)(spec->width - length) : 0u;
+
+	if( (spec->flags & LCD_FORMAT_LEFT) == 0u )
+	{
+		returnValue = LCD_FormatPad(lcd, putChar, ' ', padCount);
+	}
+
+	for(uint8_t i = 0u; (i < length) && (returnValue == STATUS_OK); i++)
+	{
+		returnValue = putChar(lcd, (uint8_t)stringData[i]);
+	}
+
+	if( ((spec->flags & LCD_FORMAT_LEFT) == LCD_FORMAT_LEFT) && (returnValue == STATUS_OK) )
+	{
+		returnValue = LCD_FormatPad(lcd, putChar, ' ', padCount);
+	}
+
+	return returnValue;
+}
+
+static e_Status LCD_Format(st_LCDHandle *lcd, pf_PutChar putChar, const char *format, va_list args)
+{
+	e_Status returnValue = STATUS_OK;
+	st_FormatSpec spec;
+	uint8_t longValue = 0u;
+	int32_t signedValue = 0;
+	uint32_t unsignedValue = 0u;
+	char character[2u] = {'\0', '\0'};
+
+	while( (*format != '\0') && (returnValue == STATUS_OK) )
+	{
+		if(*format != '%')
+		{
+			returnValue = putChar(lcd, (uint8_t)*format);
+		}
+		else
+		{
+			format++;
+
+			spec.flags = 0u;
+			spec.width = 0u;
+			spec.precision = LCD_FORMAT_NO_PRECISION;
+			spec.base = 10u;
+			spec.decimals = 0u;
+			longValue = 0u;
+
+			/* Flags */
+			while( (*format == '-') || (*format == '0') || (*format == '+') )
+			{
+				spec.flags |= (*format == '-') ? LCD_FORMAT_LEFT : ((*format == '0') ? LCD_FORMAT_ZERO : LCD_FORMAT_PLUS);
+				format++;
+			}
+
+			/* Width and precision */
+			while( (*format >= '0') && (*format <= '9') )
+			{
+				if(spec.width <= (LCD_FORMAT_WIDTH_MAX / 10u))
+				{
+					spec.width = (uint8_t)(spec.width * 10u) + (uint8_t)(*format - '0');
+				}
+				format++;
+			}
+			if(*format == '.')
+			{
+				spec.precision = 0u;
+				format++;
+				while( (*format >= '0') && (*format <= '9') )
+				{
+					if(spec.precision <= (LCD_FORMAT_WIDTH_MAX / 10u))
+					{
+						spec.precision = (uint8_t)(spec.precision * 10u) + (uint8_t)(*format - '0');
+					}
+					format++;
+				}
+			}
+			if(*format == 'l')
+			{
+				longValue = 1u;
+				format++;
+			}
+
+			switch(*format)
+			{
+				case 'd':
+				case 'i':
+				case 'k':
+					signedValue = (longValue == 1u) ? (int32_t)va_arg(args, long) : (int32_t)va_arg(args, int);
+					if( (*format == 'k') && (spec.precision != LCD_FORMAT_NO_PRECISION) )
+					{
+						spec.decimals = (spec.precision > LCD_FORMAT_DECIMALS_MAX) ? LCD_FORMAT_DECIMALS_MAX : spec.precision;
+					}
+					/* The magnitude of INT32_MIN only fits unsigned */
+					unsignedValue = (signedValue < 0) ? (0u - (uint32_t)signedValue) : (uint32_t)signedValue;
+					returnValue = LCD_FormatNumber(lcd, putChar, unsignedValue, (signedValue < 0) ? 1u : 0u, &spec);
+					break;
+
+				case 'X':
+					spec.flags |= LCD_FORMAT_UPPER;
+					/* fall through */
+				case 'x':
+					spec.base = 16u;
+					/* fall through */
+				case 'u':
+					unsignedValue = (longValue == 1u) ? (uint32_t)va_arg(args, unsigned long) : (uint32_t)va_arg(args, unsigned int);
+					returnValue = LCD_FormatNumber(lcd, putChar, unsignedValue, 0u, &spec);
+					break;
+
+				case 'c':
+					character[0u] = (char)va_arg(args, int);
+					spec.precision = 1u;
+					returnValue = LCD_FormatString(lcd, putChar, character, &spec);
+					break;
+
+				case 's':
+					returnValue = LCD_FormatString(lcd, putChar, va_arg(args, const char*), &spec);
+					break;
+
+				case '%':
+					returnValue = putChar(lcd, '%');
+					break;
+
+				case '\0': /* Format ending with '%', stay on the end of the string */
+					format--;
+					returnValue = STATUS_NOT_OK;
+					break;
+
+				default: /* Unknown conversion, printed as it is */
+					returnValue = putChar(lcd, (uint8_t)*format);
+					break;
+			}
+		}
+		format++;
+	}
+
+	return returnValue;
+}
+
+/* Function Definition --------------------------------*/
+
+e_Status LCD_Init(st_LCDHandle *lcd, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress, uint8_t rowCount, uint8_t charCount)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (lcd != NULL) && (i2cHandle != NULL) && (rowCount != 0u) && (rowCount <= LCD_ROW_MAX) &&
+		(charCount != 0u) && (charCount <= LCD_CHAR_MAX) )
+	{
+		lcd->i2cHandle = i2cHandle;
+		lcd->deviceAddress = deviceAddress;
+		lcd->rowCount = rowCount;
+		lcd->charCount = charCount;
+
+		/* Rows 2 and 3 continue the DDRAM lines of rows 0 and 1 */
+		for(uint8_t row = 0u; row < rowCount; row++)
+		{
+			lcd->rowOffset[row] = ( ((row & 0x01) == 0u) ? LCD_ROW_0 : LCD_ROW_1 ) + (uint8_t)((row >> 1u) * charCount);
+		}
+
+		lcd->backlight = LCD_BACKLIGHT_ON;
+		lcd->stateValid = 0u;
+		lcd->addressCounter = LCD_ROW_0;
+		lcd->cgramSelected = 0u;
+		lcd->frame.printRow = 0u;
+		lcd->frame.printCol = 0u;
+#if(LCD_ASYNC_TRANSMIT == 1u)
+		lcd->frame.dropCount = queueDropCount;
+		lcd->stateDropCount = queueDropCount;
+#endif
+		lcd->glyphCache.useCount = 0u;
+		lcd->marquee.enabled = 0u;
+		for(uint8_t row = 0u; row < LCD_LINE_NO; row++)
+		{
+			lcd->marquee.text[row] = NULL;
+			lcd->marquee.size[row] = 0u;
+		}
+		lcd->marquee.statistics.stepCount = 0u;
+		lcd->marquee.statistics.transmitCount = 0u;
+		lcd->marquee.statistics.byteCount = 0u;
+		lcd->marquee.statistics.skippedCount = 0u;
+		LCD_ResetGlyphStatistics(lcd);
+		LCD_ResetTransactionStatistics(lcd);
+
+		/* Check if the device is ready */
+		returnValue = LCD_IsDeviceReady(lcd->i2cHandle, lcd->deviceAddress);
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	if(returnValue == STATUS_OK)
+	{
+		/* The LCD starts in 8-bit mode: one enable pulse per function set, and fixed waits of the data sheet
+		 * as the busy flag cannot be checked before the 4-bit mode is set */
+		LCD_Delay(LCD_POWER_ON_TIME);
+		returnValue = LCD_NibbleWrite(lcd, LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
+		LCD_Delay(LCD_INIT_WAIT_FIRST);
+		returnValue = LCD_NibbleWrite(lcd, LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
+		LCD_Delay(LCD_INIT_WAIT_SECOND);
+		returnValue = LCD_NibbleWrite(lcd, LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
+		returnValue = LCD_NibbleWrite(lcd, LCD_FUNC_SET | LCD_4BITMODE); /* Function set: 4-bit mode */
+		returnValue = LCD_CommandWriteWait(lcd, LCD_FUNC_SET | LCD_4BITMODE | LCD_2LINE | LCD_5x8DOTS); /* Function set: 4-bit mode, 2 lines, 5x8 dots */
+		lcd->displayControl = LCD_DISPLAY_CONTROL | LCD_DISPLAY_OFF | LCD_CURSOR_OFF | LCD_BLINK_OFF; /* Set display control: display off, cursor off, blink off */
+		returnValue = LCD_CommandWriteWait(lcd, lcd->displayControl);
+		returnValue = LCD_CommandWriteWait(lcd, LCD_CLEAR_DISPLAY); /* Clear display */
+		lcd->entryMode = LCD_ENTRY_MODE_SET | LCD_INCREMENT; /* Set entry mode: increment */
+		returnValue = LCD_CommandWriteWait(lcd, lcd->entryMode);
+		lcd->displayControl = LCD_DISPLAY_CONTROL | LCD_DISPLAY_ON | LCD_CURSOR_ON | LCD_BLINK_OFF; /* Set display control: display on, cursor on, blink off */
+		returnValue = LCD_CommandWriteWait(lcd, lcd->displayControl);
+
+		/* Every packet carried the backlight, the controls are known once the last one is sent */
+		lcd->stateValid = (returnValue == STATUS_OK) ? LCD_STATE_ALL : 0u;
+
+		/* The display is cleared, start with a blank framebuffer and an unknown CGRAM */
+		LCD_FrameClear(lcd);
+		LCD_SetShadow(lcd, 1u);
+		LCD_ResetGlyphSlots(lcd, LCD_SLOTS_ALL);
+	}
+	else
+	{
+
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_SetRowOffsets(st_LCDHandle *lcd, const uint8_t *rowOffset)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (lcd != NULL) && (rowOffset != NULL) )
+	{
+		returnValue = STATUS_OK;
+
+		/* A row must not run past the end of its DDRAM line */
+		for(uint8_t row = 0u; (row < lcd->rowCount) && (returnValue == STATUS_OK); row++)
+		{
+			if( ((uint8_t)(rowOffset[row] & ~LCD_ROW_1) + lcd->charCount) > LCD_LINE_LENGTH )
+			{
+				returnValue = STATUS_NOT_OK;
+			}
+		}
+
+		for(uint8_t row = 0u; (row < lcd->rowCount) && (returnValue == STATUS_OK); row++)
+		{
+			lcd->rowOffset[row] = rowOffset[row];
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_BacklightOn(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(lcd != NULL)
+	{
+		returnValue = LCD_SetBacklight(lcd, LCD_BACKLIGHT_ON);
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_BacklightOff(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(lcd != NULL)
+	{
+		returnValue = LCD_SetBacklight(lcd, 0u);
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_SetCursor(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t cursorPos = 0x00;
+
+	if(lcd != NULL)
+	{
+		returnValue = LCD_GetCursorCommand(lcd, rowPos, colPos, &cursorPos);
+	}
+
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = LCD_CommandWrite(lcd, cursorPos);
+	}
+	else
+	{
+
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_SendString(st_LCDHandle *lcd, char* stringData, uint8_t dataSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t charCode = 0u;
+
+	/* Checking is data is present in stringData */
+	if( (lcd != NULL) && (stringData != NULL) && (dataSize != 0u) )
+	{
+		returnValue = STATUS_OK;
+		for(uint8_t i =0; (i < dataSize) && (returnValue == STATUS_OK); i++)
+		{
+			charCode = (uint8_t)( *(stringData + i));
+
+			/* Escaped glyph ID, the glyph is loaded before it is displayed */
+			if( (charCode == LCD_GLYPH_ESCAPE) && ((i + 1u) < dataSize) )
+			{
+				i++;
+				returnValue = LCD_ResolveGlyph(lcd, (uint8_t)( *(stringData + i)), &charCode);
+			}
+
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = LCD_BatchAppend(lcd, charCode, LCD_SEND_DATA);
+			}
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
+		else
+		{
+			LCD_BatchDiscard();
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+
+}
+
+e_Status LCD_Printf(st_LCDHandle *lcd, const char* format, ...)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	va_list args;
+
+	if( (lcd != NULL) && (format != NULL) )
+	{
+		va_start(args, format);
+		returnValue = LCD_Format(lcd, LCD_PutDisplay, format, args);
+		va_end(args);
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
+		else
+		{
+			LCD_BatchDiscard();
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+e_Status LCD_SendCommands(st_LCDHandle *lcd, const uint8_t* cmdList, uint8_t cmdCount)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (lcd != NULL) && (cmdList != NULL) && (cmdCount != 0u) )
+	{
+		returnValue = STATUS_OK;
+		for(uint8_t i = 0u; (i < cmdCount) && (returnValue == STATUS_OK); i++)
+		{
+			if(LCD_CacheControl(lcd, cmdList[i]) == 0u)
+			{
+				returnValue = LCD_BatchAppend(lcd, cmdList[i], 0u);
+			}
+
+			/* Clear and return home take 1.52 ms, nothing can follow them in the same transmit */
+			if( (returnValue == STATUS_OK) && ((cmdList[i] == LCD_CLEAR_DISPLAY) || ((cmdList[i] & 0xFE) == LCD_RET_HOME)) )
+			{
+				returnValue = LCD_BatchSend();
+				if(returnValue == STATUS_OK)
+				{
+					returnValue = LCD_WaitExecution(lcd, cmdList[i]);
+				}
+			}
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
+		else
+		{
+			LCD_BatchDiscard();
+		}
+
+		if(returnValue != STATUS_OK)
+		{
+			/* The cached commands may not have reached the LCD */
+			lcd->stateValid &= LCD_STATE_BACKLIGHT;
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
-/**
- * @brief  Sends data to the LCD.
- *
- * This function sends a data byte to the LCD.
- * It divides the byte into two nibbles and transmits
- * each nibble sequentially.
- *
- * @param  data The data byte to be sent.
- * @return e_Status Returns the status of the transmission.
- */
-e_Status LCD_DataWrite(uint8_t data);
+	return returnValue;
+}
 
+e_Status LCD_DisplayOn(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-/* Static Function Definition -------------------------*/
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl | LCD_DISPLAY_ON);
+	}
+
+	return returnValue;
+}
 
-e_Status LCD_CommandWrite(uint8_t cmd)
+e_Status LCD_DisplayOff(st_LCDHandle *lcd)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t sendPacket[LCD_PACKET_SZ] = {0x00};
-    uint8_t dataMSB = 0u;  /* Most significant nibble of command */
-    uint8_t dataLSB = 0u;  /* Least significant nibble of command */
 
-    dataMSB = cmd & 0xF0;  /* Extract the most significant nibble */
-    dataLSB = (cmd << 4u) & 0xF0;  /* Extract the least significant nibble */
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl & (uint8_t)~LCD_DISPLAY_ON);
+	}
 
-    /* Set backlight and enable high for MSB data packet */
-	dataMSB |= LCD_BACKLIGHT_ON | LCD_ENABLE_HIGH;
-	sendPacket[0u] = dataMSB;
+	return returnValue;
+}
 
-	/* Set enable low */
-	dataMSB &= LCD_ENABLE_LOW;
-	sendPacket[1u] = dataMSB;
+e_Status LCD_CursorOn(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-    /* Set backlight and enable high for LSB data packet */
-	dataLSB |= LCD_BACKLIGHT_ON | LCD_ENABLE_HIGH;
-	sendPacket[2u] = dataLSB;
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl | LCD_CURSOR_ON);
+	}
 
-	/* Set enable low */
-	dataLSB &= LCD_ENABLE_LOW;
-	sendPacket[3u] = dataLSB;
+	return returnValue;
+}
+
+e_Status LCD_CursorOff(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-	returnValue = LCD_Transmit(sendPacket, LCD_PACKET_SZ);
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl & (uint8_t)~LCD_CURSOR_ON);
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_DataWrite(uint8_t data)
+e_Status LCD_BlinkOn(st_LCDHandle *lcd)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t sendPacket[LCD_PACKET_SZ] = {0x00};
-    uint8_t dataMSB = 0u;  /* Most significant nibble of data */
-    uint8_t dataLSB = 0u;  /* Least significant nibble of data */
 
-    dataMSB = data & 0xF0;  /* Extract the most significant nibble */
-    dataLSB = (data << 4u) & 0xF0;  /* Extract the least significant nibble */
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl | LCD_BLINK_ON);
+	}
 
-    /* Set backlight, send data, and enable high for MSB data packet*/
-	dataMSB |= LCD_BACKLIGHT_ON | LCD_SEND_DATA | LCD_ENABLE_HIGH;
-	sendPacket[0u] = dataMSB;
+	return returnValue;
+}
 
-	/* Set enable low */
-	dataMSB &= LCD_ENABLE_LOW;
-	sendPacket[1u] = dataMSB;
+e_Status LCD_BlinkOff(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-    /* Set backlight, send data, and enable high for LSB data packet*/
-	dataLSB |= LCD_BACKLIGHT_ON | LCD_SEND_DATA | LCD_ENABLE_HIGH;
-	sendPacket[2u] = dataLSB;
+	if(lcd != NULL)
+	{
+		returnValue = LCD_ControlWrite(lcd, lcd->displayControl & (uint8_t)~LCD_BLINK_ON);
+	}
 
-	/* Set enable low */
-	dataLSB &= LCD_ENABLE_LOW;
-	sendPacket[3u] = dataLSB;
+	return returnValue;
+}
+
+e_Status LCD_ClearDisplay(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-	returnValue = LCD_Transmit(sendPacket, LCD_PACKET_SZ);
+	if(lcd != NULL)
+	{
+		/* The clear also returns the display shift home */
+		lcd->marquee.enabled = 0u;
+		(void)LCD_CacheControl(lcd, LCD_CLEAR_DISPLAY);
+		returnValue = LCD_CommandWriteWait(lcd, LCD_CLEAR_DISPLAY);
+
+		/* The LCD is blank, the framebuffer is kept and sent again by the next flush */
+		LCD_SetShadow(lcd, (returnValue == STATUS_OK) ? 1u : 0u);
+	}
 
 	return returnValue;
 }
 
-/* Function Definition --------------------------------*/
+e_Status LCD_FrameWrite(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, const char* stringData, uint8_t dataSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	e_Status glyphStatus = STATUS_OK;
+	uint8_t col = colPos;
+	uint8_t charCode = 0u;
+
+	if( (lcd != NULL) && (stringData != NULL) && (rowPos < lcd->rowCount) && (colPos < lcd->charCount) )
+	{
+		returnValue = STATUS_OK;
+
+		/* Clip the string at the end of the row */
+		for(uint8_t i = 0u; (i < dataSize) && (col < lcd->charCount); i++)
+		{
+			charCode = (uint8_t)stringData[i];
+
+			/* Escaped glyph ID, the overwritten cell does not keep its slot in use */
+			if( (charCode == LCD_GLYPH_ESCAPE) && ((i + 1u) < dataSize) )
+			{
+				i++;
+				lcd->frame.frameBuffer[rowPos][col] = LCD_BLANK_CHAR;
+				glyphStatus = LCD_ResolveGlyph(lcd, (uint8_t)stringData[i], &charCode);
+				if(glyphStatus == STATUS_OK)
+				{
+					glyphStatus = LCD_BatchSend();
+				}
+
+				if(glyphStatus != STATUS_OK)
+				{
+					/* The glyph is left blank, the rest of the string is written */
+					LCD_BatchDiscard();
+					charCode = LCD_BLANK_CHAR;
+					returnValue = glyphStatus;
+				}
+			}
+
+			lcd->frame.frameBuffer[rowPos][col] = charCode;
+			col++;
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
 
-e_Status LCD_Init()
+e_Status LCD_FramePrintf(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, const char* format, ...)
 {
 	e_Status returnValue = STATUS_NOT_OK;
+	va_list args;
 
-	/* Check if the device is ready */
-	returnValue = LCD_IsDeviceReady();
+	if( (lcd != NULL) && (format != NULL) && (rowPos < lcd->rowCount) && (colPos < lcd->charCount) )
+	{
+		lcd->frame.printRow = rowPos;
+		lcd->frame.printCol = colPos;
 
-	if(returnValue == STATUS_OK)
+		va_start(args, format);
+		returnValue = LCD_Format(lcd, LCD_PutFrame, format, args);
+		va_end(args);
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+void LCD_FrameClear(st_LCDHandle *lcd)
+{
+	if(lcd != NULL)
+	{
+		for(uint8_t row = 0u; row < LCD_ROW_MAX; row++)
+		{
+			for(uint8_t col = 0u; col < LCD_CHAR_MAX; col++)
+			{
+				lcd->frame.frameBuffer[row][col] = LCD_BLANK_CHAR;
+			}
+		}
+	}
+}
+
+void LCD_FrameInvalidate(st_LCDHandle *lcd)
+{
+	if(lcd != NULL)
+	{
+		LCD_SetShadow(lcd, 0u);
+	}
+}
+
+e_Status LCD_Flush(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_OK;
+
+	if(lcd == NULL)
+	{
+		returnValue = STATUS_NOT_OK;
+	}
+	else if(lcd->marquee.enabled == 1u)
 	{
-		COMMON_DELAY(45);
-		returnValue = LCD_CommandWrite(LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
-		COMMON_DELAY(5);
-		returnValue = LCD_CommandWrite(LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
-		COMMON_DELAY(1);
-		returnValue = LCD_CommandWrite(LCD_FUNC_SET | LCD_8BITMODE); /* Function set: 8-bit mode */
-		COMMON_DELAY(10);
-		returnValue = LCD_CommandWrite(LCD_FUNC_SET | LCD_4BITMODE); /* Function set: 4-bit mode */
-		COMMON_DELAY(10);
-		returnValue = LCD_CommandWrite(LCD_FUNC_SET | LCD_4BITMODE | LCD_2LINE | LCD_5x8DOTS); /* Function set: 4-bit mode, 2 lines, 5x8 dots */
-		COMMON_DELAY(10);
-		displayControl = LCD_DISPLAY_CONTROL | LCD_DISPLAY_OFF | LCD_CURSOR_OFF | LCD_BLINK_OFF; /* Set display control: display off, cursor off, blink off */
-		returnValue = LCD_CommandWrite(displayControl);
-		COMMON_DELAY(1);
-		returnValue = LCD_CommandWrite(LCD_CLEAR_DISPLAY); /* Clear display */
-		COMMON_DELAY(5);
-		returnValue = LCD_CommandWrite(LCD_ENTRY_MODE_SET | LCD_INCREMENT); /* Set entry mode: increment */
-		COMMON_DELAY(1);
-		displayControl = LCD_DISPLAY_CONTROL | LCD_DISPLAY_ON | LCD_CURSOR_ON | LCD_BLINK_OFF; /* Set display control: display on, cursor on, blink off */
-		returnValue = LCD_CommandWrite(displayControl);
-		COMMON_DELAY(1);
+		/* The framebuffer columns do not match the shifted display */
+		returnValue = STATUS_BUSY;
 	}
 	else
 	{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+		/* A dropped transmit leaves the LCD content unknown */
+		if(lcd->frame.dropCount != queueDropCount)
+		{
+			lcd->frame.dropCount = queueDropCount;
+			LCD_FrameInvalidate(lcd);
+		}
+#endif
+
+		for(uint8_t row = 0u; (row < lcd->rowCount) && (returnValue == STATUS_OK); row++)
+		{
+			returnValue = LCD_FlushRow(lcd, row);
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
 
+		if(returnValue != STATUS_OK)
+		{
+			/* The cells of the failed transmit are not known, send everything again next time */
+			LCD_BatchDiscard();
+			LCD_FrameInvalidate(lcd);
+		}
 	}
 
 	return returnValue;
 }
 
+e_Status LCD_MarqueeSetText(st_LCDHandle *lcd, uint8_t rowPos, const char* text, uint8_t size)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (lcd != NULL) && (rowPos < lcd->rowCount) && (rowPos < LCD_LINE_NO) )
+	{
+		lcd->marquee.text[rowPos] = text;
+		lcd->marquee.size[rowPos] = (text != NULL) ? size : 0u;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
 
-e_Status LCD_SetCursor(uint8_t rowPos, uint8_t colPos)
+e_Status LCD_MarqueeStart(st_LCDHandle *lcd, uint32_t interval)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t cursorPos = 0x00;
+	st_LCDMarquee *marquee = NULL;
+	uint8_t lineCmd = 0x00;
+	uint8_t lineStart = 1u;
 
-	/* Check if the row and column input are withine range */
-	if(rowPos < LCD_ROW_NO && colPos < LCD_CHAR_NO)
+	/* The display shift moves whole DDRAM lines, a row must be a whole line from its first address */
+	if(lcd != NULL)
 	{
-		switch(rowPos)
+		for(uint8_t row = 0u; row < lcd->rowCount; row++)
 		{
-			case 0u: /* Set cursor position for row 0 */
-				cursorPos = colPos | LCD_SET_DDRAM_ADDR |  LCD_ROW_0;
-				returnValue = STATUS_OK;
-				break;
+			if( (lcd->rowOffset[row] & (uint8_t)~LCD_ROW_1) != 0u )
+			{
+				lineStart = 0u;
+			}
+		}
+	}
+
+	if( (lcd != NULL) && (interval != 0u) && (lcd->rowCount <= LCD_LINE_NO) && (lineStart == 1u) )
+	{
+		marquee = &lcd->marquee;
+		marquee->enabled = 0u;
 
-			case 1u: /* Set cursor position for row 1 */
-				cursorPos = colPos | LCD_SET_DDRAM_ADDR |  LCD_ROW_1;
-				returnValue = STATUS_OK;
-				break;
+		/* Back to the first DDRAM column, the LCD content is replaced */
+		returnValue = LCD_CommandWriteWait(lcd, LCD_RET_HOME);
+		LCD_SetShadow(lcd, 0u);
 
-			default: //Code should not come here
-				returnValue = STATUS_NOT_OK;
-				break;
+		/* Load the whole DDRAM lines, also the hidden columns */
+		for(uint8_t row = 0u; (row < lcd->rowCount) && (returnValue == STATUS_OK); row++)
+		{
+			returnValue = LCD_GetCursorCommand(lcd, row, 0u, &lineCmd);
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = LCD_BatchAppend(lcd, lineCmd, 0u);
+			}
+			for(uint8_t cell = 0u; (cell < LCD_LINE_LENGTH) && (returnValue == STATUS_OK); cell++)
+			{
+				returnValue = LCD_BatchAppend(lcd, (cell < marquee->size[row]) ? (uint8_t)marquee->text[row][cell] : LCD_BLANK_CHAR, LCD_SEND_DATA);
+			}
+			marquee->textIndex[row] = (marquee->size[row] > LCD_LINE_LENGTH) ? LCD_LINE_LENGTH : 0u;
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
+		else
+		{
+			LCD_BatchDiscard();
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			marquee->interval = interval;
+			marquee->stepTick = COMMON_GET_TICK();
+			marquee->offset = 0u;
+			marquee->enabled = 1u;
 		}
 	}
 	else
@@ -177,29 +2048,61 @@ e_Status LCD_SetCursor(uint8_t rowPos, uint8_t colPos)
 		/* Error Handling */
 	}
 
-	if(returnValue == STATUS_OK)
+	return returnValue;
+}
+
+e_Status LCD_MarqueeStop(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(lcd != NULL)
 	{
-		returnValue = LCD_CommandWrite(cursorPos);
+		lcd->marquee.enabled = 0u;
+		returnValue = LCD_CommandWriteWait(lcd, LCD_RET_HOME);
+
+		/* The DDRAM holds the marquee, the framebuffer is sent again */
+		LCD_SetShadow(lcd, 0u);
 	}
-	else
+
+	return returnValue;
+}
+
+e_Status LCD_MarqueeProcess(st_LCDHandle *lcd)
+{
+	e_Status returnValue = STATUS_OK;
+	st_LCDMarquee *marquee = NULL;
+	uint32_t currentTick = 0u;
+
+	if( (lcd != NULL) && (lcd->marquee.enabled == 1u) )
 	{
+		marquee = &lcd->marquee;
+		currentTick = COMMON_GET_TICK();
+
+		if( (uint32_t)(currentTick - marquee->stepTick) >= marquee->interval )
+		{
+			/* Keep the steps on the interval grid, a late call does not catch up */
+			marquee->stepTick += marquee->interval;
+			while( (uint32_t)(currentTick - marquee->stepTick) >= marquee->interval )
+			{
+				marquee->stepTick += marquee->interval;
+				marquee->statistics.skippedCount++;
+			}
 
+			returnValue = LCD_MarqueeStep(lcd);
+		}
 	}
 
 	return returnValue;
 }
 
-e_Status LCD_SendString(char* stringData, uint8_t dataSize)
+e_Status LCD_GetMarqueeStatistics(st_LCDHandle *lcd, st_MarqueeStatistics *statistics)
 {
 	e_Status returnValue = STATUS_NOT_OK;
 
-	/* Checking is data is present in stringData */
-	if( (stringData != NULL) && (dataSize != 0u) )
+	if( (lcd != NULL) && (statistics != NULL) )
 	{
-		for(uint8_t i =0; i < dataSize; i++)
-		{
-			LCD_DataWrite((uint8_t)( *(stringData + i)));
-		}
+		*statistics = lcd->marquee.statistics;
+		returnValue = STATUS_OK;
 	}
 	else
 	{
@@ -207,75 +2110,244 @@ e_Status LCD_SendString(char* stringData, uint8_t dataSize)
 	}
 
 	return returnValue;
-
 }
 
-e_Status LCD_DisplayOn()
+e_Status LCD_RegisterGlyph(uint8_t glyphId, const uint8_t *bitmap)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl |= LCD_DISPLAY_ON;
 
-	returnValue = LCD_CommandWrite(displayControl);
+	if(glyphId < LCD_GLYPH_MAX)
+	{
+		/* The glyph is shared by every LCD, the slots holding the previous glyph are outdated */
+		glyphTable[glyphId] = bitmap;
+		glyphVersion[glyphId]++;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_DisplayOff()
+e_Status LCD_LoadGlyph(st_LCDHandle *lcd, uint8_t glyphId, uint8_t *charCode)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl &= ~LCD_DISPLAY_ON;
 
-	returnValue = LCD_CommandWrite(displayControl);
+	if( (lcd != NULL) && (charCode != NULL) )
+	{
+		returnValue = LCD_ResolveGlyph(lcd, glyphId, charCode);
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = LCD_BatchSend();
+		}
+		else
+		{
+			LCD_BatchDiscard();
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_CursorOn()
+e_Status LCD_GetGlyphStatistics(st_LCDHandle *lcd, st_GlyphStatistics *statistics)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl |= LCD_CURSOR_ON;
 
-	returnValue = LCD_CommandWrite(displayControl);
+	if( (lcd != NULL) && (statistics != NULL) )
+	{
+		*statistics = lcd->glyphCache.statistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_CursorOff()
+void LCD_ResetGlyphStatistics(st_LCDHandle *lcd)
+{
+	if(lcd != NULL)
+	{
+		lcd->glyphCache.statistics.hitCount = 0u;
+		lcd->glyphCache.statistics.uploadCount = 0u;
+		lcd->glyphCache.statistics.cgramWriteCount = 0u;
+	}
+}
+
+e_Status LCD_FrameCommit(st_LCDHandle *lcd)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl &= ~LCD_CURSOR_ON;
 
-	returnValue = LCD_CommandWrite(displayControl);
+	if(lcd != NULL)
+	{
+		returnValue = STATUS_OK;
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+		/* The frame must not be split at the end of the queue buffer, the queue is rewound only if the
+		 * worst case frame of this LCD does not fit up to the end. The frames of several LCDs are queued back-to-back */
+		if( (LCD_QUEUE_SIZE - (queueHead & (LCD_QUEUE_SIZE - 1u))) < ((uint16_t)lcd->rowCount * (lcd->charCount + 1u) * LCD_PACKET_SZ) )
+		{
+			returnValue = LCD_QueueWaitEmpty();
+			if(returnValue == STATUS_OK)
+			{
+				LCD_QueueRewind();
+			}
+		}
+#endif
+	}
+
+	if(returnValue == STATUS_OK)
+	{
+		/* The worst case frame fits the batch, it is sent by the end of the flush only */
+		batchLimit = LCD_FRAME_STREAM_SIZE;
+		returnValue = LCD_Flush(lcd);
+		batchLimit = LCD_BATCH_MAX_SIZE;
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_BlinkOn()
+e_Status LCD_FrameCommitGroup(st_LCDHandle **lcdList, uint8_t lcdCount)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl |= LCD_BLINK_ON;
+	e_Status commitStatus = STATUS_OK;
+
+	if( (lcdList != NULL) && (lcdCount != 0u) )
+	{
+		returnValue = STATUS_OK;
 
-	returnValue = LCD_CommandWrite(displayControl);
+		/* An LCD that fails does not hold back the others */
+		for(uint8_t i = 0u; i < lcdCount; i++)
+		{
+			commitStatus = LCD_FrameCommit(lcdList[i]);
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = commitStatus;
+			}
+		}
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_BlinkOff()
+e_Status LCD_GetTransactionStatistics(st_LCDHandle *lcd, st_LCDTransactionStatistics *statistics)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	displayControl &= ~LCD_BLINK_ON;
 
-	returnValue = LCD_CommandWrite(displayControl);
+	if( (lcd != NULL) && (statistics != NULL) )
+	{
+		*statistics = lcd->transactions;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Error Handling */
+	}
 
 	return returnValue;
 }
 
-e_Status LCD_ClearDisplay()
+void LCD_ResetTransactionStatistics(st_LCDHandle *lcd)
 {
-	e_Status returnValue = STATUS_NOT_OK;
+	if(lcd != NULL)
+	{
+		lcd->transactions.transmitCount = 0u;
+		lcd->transactions.byteCount = 0u;
+		lcd->transactions.elidedCount = 0u;
+	}
+}
 
-	returnValue = LCD_CommandWrite(LCD_CLEAR_DISPLAY);
-	COMMON_DELAY(2);
+e_Status LCD_WaitComplete()
+{
+	e_Status returnValue = STATUS_OK;
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	returnValue = LCD_QueueWaitEmpty();
+
+	if(returnValue == STATUS_OK)
+	{
+		/* Report and clear the error of the dropped transmits */
+		returnValue = queueStatus;
+		queueStatus = STATUS_OK;
+	}
+#endif
 
 	return returnValue;
 }
+
+uint8_t LCD_IsBusy()
+{
+	uint8_t isBusy = 0u;
+
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	isBusy = ( (queueHead != queueTail) || (transferLength != 0u) ) ? 1u : 0u;
+#endif
+
+	return isBusy;
+}
+
+void LCD_SetTransmitCallback(pf_TransmitCallback callback)
+{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	transmitCallback = callback;
+#else
+	(void)callback;
+#endif
+}
+
+void LCD_TransmitCompleteCallback()
+{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	if(transferLength != 0u)
+	{
+		queueTail = queueTail + transferLength;
+		segmentSent = segmentSent + transferLength;
+		transferLength = 0u;
+
+		/* Next segment, possibly to another LCD */
+		if(segmentSent == segmentLength[segmentTail & (LCD_QUEUE_SEGMENTS - 1u)])
+		{
+			segmentTail = segmentTail + 1u;
+			segmentSent = 0u;
+		}
+
+		LCD_QueueStart();
+
+		/* Notify once everything queued is on the bus */
+		if( (transferLength == 0u) && (transmitCallback != NULL) )
+		{
+			transmitCallback(STATUS_OK);
+		}
+	}
+#endif
+}
+
+void LCD_TransmitErrorCallback()
+{
+#if(LCD_ASYNC_TRANSMIT == 1u)
+	/* Drop everything queued, the order of the writes is lost */
+	queueTail = queueHead;
+	segmentTail = segmentHead;
+	segmentSent = 0u;
+	transferLength = 0u;
+	queueStatus = STATUS_NOT_OK;
+	queueDropCount++;
+
+	if(transmitCallback != NULL)
+	{
+		transmitCallback(STATUS_NOT_OK);
+	}
+#endif
+}
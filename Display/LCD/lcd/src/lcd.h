@@ -29,6 +29,18 @@
 
 #define LCD_PACKET_SZ			4u
 
+/* Busy flag read, the data pins are released (set high) on the PCF8574 port to be used as inputs */
+#define LCD_DATA_RELEASE		0xF0
+#define LCD_BUSY_FLAG			0x80
+
+/* Timing (Refer HD44780 Data sheet) */
+#define LCD_POWER_ON_TIME		40u		/* in ms, after VCC rises to 2.7 V */
+#define LCD_INIT_WAIT_FIRST		5u		/* in ms, after the first function set (4.1 ms) */
+#define LCD_INIT_WAIT_SECOND	1u		/* in ms, after the second function set (100 us) */
+#define LCD_EXEC_TIME_LONG		1520u	/* in us, clear display and return home */
+#define LCD_EXEC_TIME_SHORT		37u		/* in us, other instructions */
+#define LCD_EXEC_TIME_COVERED	90u		/* in us, shortest transmit of the next packet (4 bytes at 400 kHz), no wait needed below */
+
 /* Instructions */
 #define LCD_CLEAR_DISPLAY		0x01
 #define LCD_RET_HOME			0x02
@@ -76,18 +88,160 @@
 #define	LCD_CURSOR_MOVE			0x00
 
 /* Shift to Right/Left */
-#define LCD_SHIFT_RIGHT			0x40
+#define LCD_SHIFT_RIGHT			0x04
 #define LCD_SHIFT_LEFT			0x00
 
 /* Row number */
 #define LCD_ROW_0				0x00
 #define LCD_ROW_1				0x40
+#define LCD_LINE_LENGTH			0x28	/* DDRAM addresses per line in 2-line mode */
+#define LCD_LINE_NO				2u		/* DDRAM lines, rows 2 and 3 of a 4 row LCD continue lines 0 and 1 */
+
+/* Geometry, the largest LCD instance sizes the framebuffers of every instance */
+#define LCD_ROW_MAX				4u
+#define LCD_CHAR_MAX			20u
+
+/* Default address of the PCF8574 module (8-bit write address) */
+#define LCD_I2C_ADDRESS			0x4E
+
+/* Controls cached by the LCD context, a write of the cached state is skipped */
+#define LCD_STATE_DISPLAY		0x01	/* Display on/off control */
+#define LCD_STATE_ENTRY_MODE	0x02	/* Entry mode set */
+#define LCD_STATE_BACKLIGHT		0x04
+#define LCD_STATE_ALL			(LCD_STATE_DISPLAY | LCD_STATE_ENTRY_MODE | LCD_STATE_BACKLIGHT)
+
+/* Framebuffer */
+#define LCD_BLANK_CHAR			' '
+#define LCD_WRITE_THROUGH_CELLS	1u		/* Clean cells rewritten instead of a cursor jump, a jump costs as much as one character */
+
+/* Custom glyphs */
+#define LCD_CGRAM_SLOTS			8u		/* 5x8 characters in the CGRAM, character codes 0 to 7 */
+#define LCD_GLYPH_ROWS			8u		/* Bytes per glyph, one per row, 5 low bits used */
+#define LCD_GLYPH_ESCAPE		0x1B	/* In a string, followed by a glyph ID to display the glyph */
+#define LCD_GLYPH_NONE			0xFF	/* Empty CGRAM slot */
+#define LCD_SLOTS_ALL			0xFF	/* One bit per CGRAM slot */
+
+/* Formatted output */
+#define LCD_FORMAT_LEFT			0x01	/* '-' flag, left aligned in the width */
+#define LCD_FORMAT_ZERO			0x02	/* '0' flag, numbers padded with zeros */
+#define LCD_FORMAT_PLUS			0x04	/* '+' flag, sign of the positive numbers */
+#define LCD_FORMAT_UPPER		0x08	/* Upper case hexadecimal digits */
+#define LCD_FORMAT_NO_PRECISION	0xFF
+#define LCD_FORMAT_WIDTH_MAX	99u		/* Largest width or precision of a conversion */
+#define LCD_FORMAT_DECIMALS_MAX	9u		/* Largest number of decimals of a fixed-point conversion */
+#define LCD_FORMAT_DIGITS_SIZE	12u		/* 32-bit number with decimal point, "4.294967295" */
+
+/* Marquee, scrolled with the display shift instruction over the LCD_LINE_LENGTH characters of each DDRAM line */
+#define LCD_MARQUEE_STEP		(LCD_DISP_CURSOR_SHIFT | LCD_DISPLAY_SHIFT | LCD_SHIFT_LEFT)
 
 
 /* Enums ----------------------------------------------*/
 
 /* Structures -----------------------------------------*/
 
+/* Statistics of the custom glyphs */
+typedef struct
+{
+	uint32_t hitCount; /* Glyphs already in the CGRAM */
+	uint32_t uploadCount; /* Glyphs written in the CGRAM */
+	uint32_t cgramWriteCount; /* Bytes written in the CGRAM */
+}st_GlyphStatistics;
+
+/* Statistics of the marquee, transmitCount / stepCount is the cost of a scroll step */
+typedef struct
+{
+	uint32_t stepCount; /* Scroll steps sent */
+	uint32_t transmitCount; /* I2C transmits of the scroll steps */
+	uint32_t byteCount; /* Bytes of the scroll steps */
+	uint32_t skippedCount; /* Steps missed by a late LCD_MarqueeProcess() */
+}st_MarqueeStatistics;
+
+/* Output of one formatted character to an LCD instance */
+struct st_LCDHandle;
+typedef e_Status (*pf_PutChar)(struct st_LCDHandle *lcd, uint8_t character);
+
+/* Conversion of the formatted output, "%[flags][width][.precision]type" */
+typedef struct
+{
+	uint8_t flags; /* LCD_FORMAT_LEFT, LCD_FORMAT_ZERO, LCD_FORMAT_PLUS, LCD_FORMAT_UPPER */
+	uint8_t width; /* Minimum number of characters */
+	uint8_t precision; /* Decimals of %k, maximum length of %s, LCD_FORMAT_NO_PRECISION if not set */
+	uint8_t base; /* 10 or 16 */
+	uint8_t decimals; /* Digits after the decimal point */
+}st_FormatSpec;
+
+/* Notification of the end of the queued transmits, with STATUS_OK or STATUS_NOT_OK on a bus error */
+typedef void (*pf_TransmitCallback)(e_Status transmitStatus);
+
+/* I2C transmits of an LCD instance */
+typedef struct
+{
+	uint32_t transmitCount;
+	uint32_t byteCount; /* Bytes of the transmits, without the address byte */
+	uint32_t elidedCount; /* Writes skipped as the LCD was already in the state */
+}st_LCDTransactionStatistics;
+
+/* Framebuffer of an LCD instance, a cell is dirty when the shadow (LCD content) differs */
+typedef struct
+{
+	uint8_t frameBuffer[LCD_ROW_MAX][LCD_CHAR_MAX]; /* Content to be displayed */
+	uint8_t shadowBuffer[LCD_ROW_MAX][LCD_CHAR_MAX]; /* Content of the LCD, followed for the direct writes too */
+	uint8_t shadowValid[LCD_ROW_MAX][LCD_CHAR_MAX]; /* 0 if the LCD content of the cell is unknown */
+	uint8_t printRow; /* Position of LCD_FramePrintf() */
+	uint8_t printCol;
+	uint32_t dropCount; /* Dropped transmit queues already handled by the flush */
+}st_LCDFrame;
+
+/* CGRAM slots of an LCD instance */
+typedef struct
+{
+	uint8_t slotGlyph[LCD_CGRAM_SLOTS]; /* Glyph ID loaded in each CGRAM slot, LCD_GLYPH_NONE if empty */
+	uint16_t slotVersion[LCD_CGRAM_SLOTS]; /* Registration of the glyph loaded, an outdated glyph is loaded again */
+	uint32_t slotLastUse[LCD_CGRAM_SLOTS]; /* Use count at the last use of each slot, for the LRU replacement */
+	uint32_t useCount;
+	st_GlyphStatistics statistics;
+}st_LCDGlyphCache;
+
+/* Marquee of an LCD instance */
+typedef struct
+{
+	uint8_t enabled;
+	uint32_t interval; /* in ms */
+	uint32_t stepTick; /* Tick of the last step */
+	uint8_t offset; /* DDRAM address of the first visible column, 0- LCD_LINE_LENGTH */
+	const char *text[LCD_LINE_NO];
+	uint8_t size[LCD_LINE_NO];
+	uint8_t textIndex[LCD_LINE_NO]; /* Next character of a text longer than LCD_LINE_LENGTH */
+	st_MarqueeStatistics statistics;
+}st_LCDMarquee;
+
+/* Context of one LCD. One context per LCD, passed to every LCD_* function of the LCD. The instances share
+ * the encoder, the batch and the transmit queue of the driver */
+typedef struct st_LCDHandle
+{
+	/* Bus of the LCD */
+	I2C_HandleTypeDef   *i2cHandle;
+	uint8_t              deviceAddress;		/* 8-bit write address of the PCF8574, e.g. LCD_I2C_ADDRESS */
+
+	/* Geometry */
+	uint8_t              rowCount;
+	uint8_t              charCount;
+	uint8_t              rowOffset[LCD_ROW_MAX];	/* DDRAM address of the first column of each row */
+
+	uint8_t              backlight;			/* LCD_BACKLIGHT_ON or 0, sent with every byte */
+	uint8_t              displayControl;	/* Display on/off control instruction, cursor and blink */
+	uint8_t              entryMode;			/* Entry mode set instruction */
+	uint8_t              stateValid;		/* LCD_STATE_* of the controls known to be on the LCD */
+	uint32_t             stateDropCount;	/* Dropped transmit queues already handled by the cache */
+	uint8_t              addressCounter;	/* DDRAM address of the cursor, followed from the bytes sent */
+	uint8_t              cgramSelected;		/* 1 while the data are written in the CGRAM */
+
+	st_LCDFrame          frame;
+	st_LCDGlyphCache     glyphCache;
+	st_LCDMarquee        marquee;
+	st_LCDTransactionStatistics transactions;
+}st_LCDHandle;
+
 /* Variables ------------------------------------------*/
 
 /* Function Declaration -------------------------------*/
@@ -95,94 +249,180 @@
 /**
  * @brief  Initializes the LCD.
  *
- * This function initializes the LCD by checking if the device is ready,
- * and then sending the necessary initialization commands.
+ * This function binds the context to the bus, checks if the device is ready,
+ * and then sends the necessary initialization commands. The row offsets are set
+ * for the geometry: 0x00, 0x40, then charCount and 0x40 + charCount for rows 2 and 3.
+ *
+ * @param  lcd Context of the LCD, owned by the application.
+ * @param  i2cHandle I2C bus the LCD is connected to.
+ * @param  deviceAddress 8-bit write address of the PCF8574 (LCD_I2C_ADDRESS).
+ * @param  rowCount The number of rows (1- LCD_ROW_MAX).
+ * @param  charCount The number of characters per row (1- LCD_CHAR_MAX).
+ * @return e_Status Returns the status of the initialization, STATUS_NOT_OK if a parameter is invalid.
+ */
+e_Status LCD_Init(st_LCDHandle *lcd, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress, uint8_t rowCount, uint8_t charCount);
+
+/**
+ * @brief  Sets the DDRAM address of the first column of each row.
+ *
+ * For the LCD with a different DDRAM mapping than the one set by LCD_Init().
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowOffset Pointer to rowCount addresses.
+ * @return e_Status Returns STATUS_OK if set, STATUS_NOT_OK if an address is invalid.
+ */
+e_Status LCD_SetRowOffsets(st_LCDHandle *lcd, const uint8_t *rowOffset);
+
+/**
+ * @brief  Turns on the backlight.
+ *
+ * The backlight is one pin of the PCF8574, it is updated with a single byte (e.g. for a PWM
+ * dimming). Nothing is sent if the backlight is already in the state.
  *
- * @return e_Status Returns the status of the initialization.
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_Init();
+e_Status LCD_BacklightOn(st_LCDHandle *lcd);
+
+/**
+ * @brief  Turns off the backlight.
+ *
+ * The backlight is one pin of the PCF8574, it is updated with a single byte (e.g. for a PWM
+ * dimming). Nothing is sent if the backlight is already in the state.
+ *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission.
+ */
+e_Status LCD_BacklightOff(st_LCDHandle *lcd);
 
  /**
   * @brief  Sets the cursor position on the LCD.
   *
   * This function sets the cursor position on the LCD to the specified row and column.
   *
-  * @param  rowPos The row position (0- LCD_ROW_NO).
-  * @param  colPos The column position (0- LCD_CHAR_NO).
+  * @param  lcd Context of the LCD.
+  * @param  rowPos The row position (0- rowCount).
+  * @param  colPos The column position (0- charCount).
   * @return e_Status Returns the status of the cursor position update.
   */
-e_Status LCD_SetCursor(uint8_t rowPos, uint8_t colPos);
+e_Status LCD_SetCursor(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos);
 
 /**
  * @brief  Sends a string to the LCD.
  *
- * This function sends a string of data to the LCD.
+ * This function sends a string of data to the LCD. The characters are packed
+ * in as few I2C transmits as possible (see LCD_BATCH_MAX_SIZE). LCD_GLYPH_ESCAPE followed
+ * by a glyph ID displays the custom glyph, loaded in the CGRAM if needed. The written cells are
+ * followed by the framebuffer, the next LCD_Flush() writes the framebuffer content back over them.
  *
+ * @param  lcd Context of the LCD.
  * @param  stringData Pointer to the string data to be sent.
  * @param  dataSize The size of the data to be sent.
+ * @return e_Status Returns the status of the transmission, STATUS_BUSY if a glyph could not be loaded
+ *         as every slot is on the LCD or in the framebuffer (the rest of the string is not sent).
+ */
+e_Status LCD_SendString(st_LCDHandle *lcd, char* stringData, uint8_t dataSize);
+
+/**
+ * @brief  Sends a formatted string to the LCD.
+ *
+ * This function formats the arguments straight into the batched writes, without a buffer,
+ * the heap or stdio. Supported conversions: "%[-0+][width][.precision][l]type" with the types
+ * d, i (signed), u (unsigned), x, X (hexadecimal), k (fixed-point: a signed integer in units of
+ * 10^-precision, "%.2k" of 2345 is "23.45"), c, s and %. Floats are not supported.
+ * The written cells are followed by the framebuffer, as for LCD_SendString().
+ *
+ * @param  lcd Context of the LCD.
+ * @param  format The format string.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_SendString(char* stringData, uint8_t dataSize);
+e_Status LCD_Printf(st_LCDHandle *lcd, const char* format, ...);
+
+/**
+ * @brief  Sends a list of commands to the LCD.
+ *
+ * This function packs the commands in as few I2C transmits as possible (see LCD_BATCH_MAX_SIZE).
+ * A display on/off control or entry mode set command of the cached state is skipped.
+ * The batch is sent and the execution time is waited after LCD_CLEAR_DISPLAY and LCD_RET_HOME.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  cmdList Pointer to the commands to be sent.
+ * @param  cmdCount The number of commands to be sent.
+ * @return e_Status Returns the status of the transmission.
+ */
+e_Status LCD_SendCommands(st_LCDHandle *lcd, const uint8_t* cmdList, uint8_t cmdCount);
 
 /**
  * @brief  Turns on the LCD display.
  *
  * This function sets the display control flag for turning on the display
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_DisplayOn();
+e_Status LCD_DisplayOn(st_LCDHandle *lcd);
 
 /**
  * @brief  Turns off the LCD display.
  *
  * This function clears the display control flag for turning off the display
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_DisplayOff();
+e_Status LCD_DisplayOff(st_LCDHandle *lcd);
 
 /**
  * @brief  Turns on the cursor.
  *
  * This function sets the display control flag for turning on the cursor
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_CursorOn();
+e_Status LCD_CursorOn(st_LCDHandle *lcd);
 
 /**
  * @brief  Turns off the cursor.
  *
  * This function clears the display control flag for turning off the cursor
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_CursorOff();
+e_Status LCD_CursorOff(st_LCDHandle *lcd);
 
 /**
  * @brief  Turns on the blinking cursor.
  *
  * This function sets the display control flag for turning on the blinking cursor
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_BlinkOn();
+e_Status LCD_BlinkOn(st_LCDHandle *lcd);
 
 /**
  * @brief  Turns off the blinking cursor.
  *
  * This function clears the display control flag for turning off the blinking cursor
- * and sends the updated display control byte to the LCD.
+ * and sends the updated display control byte to the LCD. Nothing is sent if the LCD is
+ * already in the state.
  *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_BlinkOff();
+e_Status LCD_BlinkOff(st_LCDHandle *lcd);
 
 /**
  * @brief  Clears the LCD display.
@@ -190,9 +430,260 @@ e_Status LCD_BlinkOff();
  * This function sends the clear display command to the LCD
  * and introduces a delay for the command to take effect.
  *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission.
+ */
+e_Status LCD_ClearDisplay(st_LCDHandle *lcd);
+
+/**
+ * @brief  Writes a string in the framebuffer.
+ *
+ * This function only updates the framebuffer, the LCD is updated by LCD_Flush().
+ * The string is clipped at the end of the row. LCD_GLYPH_ESCAPE followed by a glyph ID
+ * writes the custom glyph in one cell, the glyph is loaded in the CGRAM if needed.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position (0- rowCount).
+ * @param  colPos The column position (0- charCount).
+ * @param  stringData Pointer to the string data to be written.
+ * @param  dataSize The size of the data to be written.
+ * @return e_Status Returns STATUS_OK if written, STATUS_NOT_OK if the position, the data or a glyph is
+ *         invalid, STATUS_BUSY if a glyph could not be loaded as every slot is on the LCD or in the
+ *         framebuffer (the glyph cell is left blank).
+ */
+e_Status LCD_FrameWrite(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, const char* stringData, uint8_t dataSize);
+
+/**
+ * @brief  Writes a formatted string in the framebuffer.
+ *
+ * Same format as LCD_Printf(). The LCD is updated by LCD_Flush() and the string is clipped
+ * at the end of the row.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position (0- rowCount).
+ * @param  colPos The column position (0- charCount).
+ * @param  format The format string.
+ * @return e_Status Returns STATUS_OK if written, STATUS_NOT_OK if the position or the format is invalid.
+ */
+e_Status LCD_FramePrintf(st_LCDHandle *lcd, uint8_t rowPos, uint8_t colPos, const char* format, ...);
+
+/**
+ * @brief  Clears the framebuffer.
+ *
+ * This function fills the framebuffer with blank characters, the LCD is updated by LCD_Flush().
+ *
+ * @param  lcd Context of the LCD.
+ */
+void LCD_FrameClear(st_LCDHandle *lcd);
+
+/**
+ * @brief  Marks every cell of the framebuffer as changed.
+ *
+ * The next LCD_Flush() rewrites the whole display. The writes of the driver (LCD_SendString(),
+ * LCD_Printf(), LCD_SendCommands()) are followed by the framebuffer, this is only needed when the
+ * LCD content was changed otherwise (e.g. a reset of the LCD).
+ *
+ * @param  lcd Context of the LCD.
+ */
+void LCD_FrameInvalidate(st_LCDHandle *lcd);
+
+/**
+ * @brief  Sends the changed cells of the framebuffer to the LCD.
+ *
+ * This function compares the framebuffer with the content of the LCD and only sends the cells
+ * that changed. Short gaps of unchanged cells are written through instead of moving the cursor.
+ * A cell that failed to be sent is sent again by the next flush.
+ *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission, STATUS_BUSY while the marquee runs.
+ */
+e_Status LCD_Flush(st_LCDHandle *lcd);
+
+/**
+ * @brief  Sets the text scrolled on a row by the marquee.
+ *
+ * The text is read when it is scrolled, it must stay valid while the marquee runs. A text up to
+ * LCD_LINE_LENGTH characters is followed by blanks and repeats every LCD_LINE_LENGTH steps, a
+ * longer text is written in the hidden part of the DDRAM line while scrolling. Applied by the next
+ * LCD_MarqueeStart().
+ *
+ * @param  lcd Context of the LCD.
+ * @param  rowPos The row position (0- rowCount), the LCD must have up to LCD_LINE_NO rows.
+ * @param  text Pointer to the text, NULL for a blank row.
+ * @param  size The size of the text.
+ * @return e_Status Returns STATUS_OK if set, STATUS_NOT_OK if the row is invalid.
+ */
+e_Status LCD_MarqueeSetText(st_LCDHandle *lcd, uint8_t rowPos, const char* text, uint8_t size);
+
+/**
+ * @brief  Starts the marquee.
+ *
+ * The DDRAM lines are loaded with the texts, then LCD_MarqueeProcess() scrolls both rows to the
+ * left by one column every interval (the display shift moves every row). LCD_Flush() is not
+ * available until LCD_MarqueeStop().
+ *
+ * @param  lcd Context of the LCD.
+ * @param  interval The time between two steps in ms, not 0.
+ * @return e_Status Returns the status of the transmission, STATUS_NOT_OK if the interval is invalid or a
+ *         row does not start at the first address of a DDRAM line (see LCD_SetRowOffsets()).
+ */
+e_Status LCD_MarqueeStart(st_LCDHandle *lcd, uint32_t interval);
+
+/**
+ * @brief  Stops the marquee.
+ *
+ * The display shift is returned home and the next LCD_Flush() rewrites the framebuffer.
+ *
+ * @param  lcd Context of the LCD.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_ClearDisplay();
+e_Status LCD_MarqueeStop(st_LCDHandle *lcd);
+
+/**
+ * @brief  Scrolls the marquee when a step is due, without blocking.
+ *
+ * To be called periodically. A step costs one display shift instruction, plus one character per
+ * row with a text longer than LCD_LINE_LENGTH, in one I2C transmit.
+ *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission, STATUS_OK if no step was due.
+ */
+e_Status LCD_MarqueeProcess(st_LCDHandle *lcd);
+
+/**
+ * @brief  Gets the statistics of the marquee.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  statistics Pointer to store the statistics.
+ * @return e_Status Returns STATUS_OK if read, STATUS_NOT_OK if the pointer is invalid.
+ */
+e_Status LCD_GetMarqueeStatistics(st_LCDHandle *lcd, st_MarqueeStatistics *statistics);
+
+/**
+ * @brief  Registers a custom glyph.
+ *
+ * The glyph is only written in the CGRAM when it is displayed (LCD_LoadGlyph(), or
+ * LCD_GLYPH_ESCAPE in a string). Registering an ID again replaces its glyph.
+ *
+ * @param  glyphId The glyph ID (0- LCD_GLYPH_MAX).
+ * @param  bitmap Pointer to the LCD_GLYPH_ROWS rows of the glyph, must stay valid. NULL to remove the glyph.
+ * @return e_Status Returns STATUS_OK if registered, STATUS_NOT_OK if the ID is out of range.
+ */
+e_Status LCD_RegisterGlyph(uint8_t glyphId, const uint8_t *bitmap);
+
+/**
+ * @brief  Loads a custom glyph in the CGRAM.
+ *
+ * A glyph already in the CGRAM is not written again. Otherwise the least recently used slot,
+ * which is neither on the LCD nor in the framebuffer, is replaced. The cursor position is kept.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  glyphId The glyph ID (0- LCD_GLYPH_MAX).
+ * @param  charCode Pointer to store the character code of the glyph (0- LCD_CGRAM_SLOTS).
+ * @return e_Status Returns STATUS_OK if loaded, STATUS_NOT_OK if the glyph is not registered or
+ *         on a transmit error, STATUS_BUSY if every slot is on the LCD or in the framebuffer.
+ */
+e_Status LCD_LoadGlyph(st_LCDHandle *lcd, uint8_t glyphId, uint8_t *charCode);
+
+/**
+ * @brief  Gets the statistics of the custom glyphs.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  statistics Pointer to store the statistics.
+ * @return e_Status Returns STATUS_OK if read, STATUS_NOT_OK if the pointer is invalid.
+ */
+e_Status LCD_GetGlyphStatistics(st_LCDHandle *lcd, st_GlyphStatistics *statistics);
+
+/**
+ * @brief  Resets the statistics of the custom glyphs.
+ *
+ * @param  lcd Context of the LCD.
+ */
+void LCD_ResetGlyphStatistics(st_LCDHandle *lcd);
+
+/**
+ * @brief  Sends the changed cells of the whole framebuffer in one I2C transmit.
+ *
+ * The framebuffer is the back buffer composed by the application, the LCD content the front
+ * buffer. The minimal stream of every row is sent back-to-back in a single transmit, the LCD
+ * never shows a half updated frame. With the asynchronous transmit, the previous writes are waited
+ * for only if the frame would wrap at the end of the transmit queue.
+ *
+ * @param  lcd Context of the LCD.
+ * @return e_Status Returns the status of the transmission, STATUS_BUSY while the marquee runs,
+ *         STATUS_TIMEOUT if the previous writes were not transmitted within LCD_TIMEOUT.
+ */
+e_Status LCD_FrameCommit(st_LCDHandle *lcd);
+
+/**
+ * @brief  Commits the frames of several LCDs in one bus round.
+ *
+ * Each frame is sent in one I2C transmit (see LCD_FrameCommit()). With the asynchronous transmit,
+ * the frames are queued back-to-back and transmitted from the interrupt.
+ *
+ * @param  lcdList Pointer to the contexts of the LCDs.
+ * @param  lcdCount The number of LCDs.
+ * @return e_Status Returns STATUS_OK if every frame was committed, the first error otherwise.
+ */
+e_Status LCD_FrameCommitGroup(st_LCDHandle **lcdList, uint8_t lcdCount);
+
+/**
+ * @brief  Gets the I2C transmits of the LCD.
+ *
+ * @param  lcd Context of the LCD.
+ * @param  statistics Pointer to store the statistics.
+ * @return e_Status Returns STATUS_OK if read, STATUS_NOT_OK if a pointer is invalid.
+ */
+e_Status LCD_GetTransactionStatistics(st_LCDHandle *lcd, st_LCDTransactionStatistics *statistics);
+
+/**
+ * @brief  Resets the I2C transmits of the LCD.
+ *
+ * @param  lcd Context of the LCD.
+ */
+void LCD_ResetTransactionStatistics(st_LCDHandle *lcd);
+
+/**
+ * @brief  Waits until every queued write is transmitted.
+ *
+ * Barrier of the asynchronous transmit (LCD_I2C_IT_COM or LCD_I2C_DMA_COM). Returns right away
+ * with the blocking transmit.
+ *
+ * @return e_Status Returns STATUS_OK if everything was transmitted, STATUS_NOT_OK if a transmit
+ *         failed since the last call, STATUS_TIMEOUT if the queue did not drain within LCD_TIMEOUT.
+ */
+e_Status LCD_WaitComplete();
+
+/**
+ * @brief  Checks if queued writes are still being transmitted.
+ *
+ * @return uint8_t 1 if busy, 0 otherwise.
+ */
+uint8_t LCD_IsBusy();
+
+/**
+ * @brief  Sets the function called when the transmit queue is drained.
+ *
+ * The callback is called from the I2C interrupt, only with the asynchronous transmit.
+ *
+ * @param  callback Function to be called, NULL to disable the notification.
+ */
+void LCD_SetTransmitCallback(pf_TransmitCallback callback);
+
+/**
+ * @brief  Continues the transmit of the queue.
+ *
+ * To be called from HAL_I2C_MasterTxCpltCallback() for the LCD I2C handler.
+ */
+void LCD_TransmitCompleteCallback();
+
+/**
+ * @brief  Drops the transmit queue after a bus error.
+ *
+ * To be called from HAL_I2C_ErrorCallback() for the LCD I2C handler. The framebuffer is sent
+ * again by the next LCD_Flush().
+ */
+void LCD_TransmitErrorCallback();
 
 
 
@@ -14,33 +14,76 @@
 #include "i2c.h"
 
 /* Macro Definition -----------------------------------*/
-#define LCD_I2C_HANDLER			&hi2c1
 #define LCD_TIMEOUT				100u
 #define LCD_TRIAL				3u
 #define LCD_MEMORY_REG_SIZE		I2C_MEMADD_SIZE_8BIT		/* If the memory register size is 8 bits(0x01) or 16 bits */
-#define LCD_I2C_ADDRESS			0x4E
 
 #define LCD_SERIAL_COM			0x00
-#define LCD_I2C_COM				0x01
+#define LCD_I2C_COM				0x01		/* Blocking I2C transmit */
+#define LCD_I2C_IT_COM			0x02		/* Interrupt driven I2C transmit, through the transmit queue */
+#define LCD_I2C_DMA_COM			0x03		/* DMA driven I2C transmit, through the transmit queue */
 
-/* Select the Communication with the LCD */
+/* Select the Communication with the LCD, can be set by the build */
+#ifndef LCD_COMMUNICATION
 #define LCD_COMMUNICATION		LCD_I2C_COM
+#endif
 
-/* Selection of LCD type */
-#define LCD_CHAR_NO				16u
-#define LCD_ROW_NO				2u
+/* Asynchronous transmit: the writes are queued and the queue is drained from the transmit complete interrupt.
+ * HAL_I2C_MasterTxCpltCallback() must call LCD_TransmitCompleteCallback() and HAL_I2C_ErrorCallback() must call
+ * LCD_TransmitErrorCallback() for the LCD I2C handler */
+#define LCD_ASYNC_TRANSMIT		( (LCD_COMMUNICATION == LCD_I2C_IT_COM) || (LCD_COMMUNICATION == LCD_I2C_DMA_COM) )
+#define LCD_QUEUE_SIZE			512u		/* Size of the transmit queue in bytes, power of 2, shared by the LCD instances */
+#define LCD_QUEUE_SEGMENTS		16u			/* Queued transmits, each one to one LCD instance, power of 2 */
+
+/* Enable this to wait for the busy flag of the LCD instead of the execution time of the instructions.
+ * Needs the R/W pin of the LCD on P1 of the PCF8574 and the blocking transmit (LCD_I2C_COM) */
+#define LCD_BUSY_FLAG_READ		0u
+
+#if(LCD_BUSY_FLAG_READ == 1u) && (LCD_COMMUNICATION != LCD_I2C_COM)
+#error "LCD_BUSY_FLAG_READ needs LCD_COMMUNICATION set to LCD_I2C_COM"
+#endif
+
+/* Maximum size of one I2C transmit of the batched writes, multiple of LCD_PACKET_SZ (4 bytes per character) */
+#define LCD_BATCH_MAX_SIZE		64u
+
+#if( (LCD_BATCH_MAX_SIZE % LCD_PACKET_SZ) != 0u )
+#error "LCD_BATCH_MAX_SIZE must be a multiple of LCD_PACKET_SZ"
+#endif
+
+/* Stream of a whole frame of the largest LCD, sent in one transmit by LCD_FrameCommit(): at most one cursor move
+ * and LCD_CHAR_MAX characters per row, the changed cells are never farther apart than a cursor move.
+ * 336 bytes for 4x20, over the 255 bytes of one I2C transfer of the STM32: the transmit size is 16 bits and
+ * the HAL sends the rest with the reload of the transfer size */
+#define LCD_FRAME_STREAM_SIZE	(LCD_ROW_MAX * (LCD_CHAR_MAX + 1u) * LCD_PACKET_SZ)
+#define LCD_TRANSFER_MAX_SIZE	( (LCD_FRAME_STREAM_SIZE > LCD_BATCH_MAX_SIZE) ? LCD_FRAME_STREAM_SIZE : LCD_BATCH_MAX_SIZE )
+
+#if( (LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1u)) != 0u ) || (LCD_QUEUE_SIZE < LCD_TRANSFER_MAX_SIZE)
+#error "LCD_QUEUE_SIZE must be a power of 2, at least LCD_BATCH_MAX_SIZE and LCD_FRAME_STREAM_SIZE"
+#endif
+
+#if( (LCD_QUEUE_SEGMENTS & (LCD_QUEUE_SEGMENTS - 1u)) != 0u ) || (LCD_QUEUE_SEGMENTS > 128u)
+#error "LCD_QUEUE_SEGMENTS must be a power of 2, up to 128"
+#endif
+
+/* Number of custom glyphs that can be registered, loaded on demand in the LCD_CGRAM_SLOTS slots of the CGRAM */
+#define LCD_GLYPH_MAX			16u
+
+#if(LCD_GLYPH_MAX > 255u)
+#error "LCD_GLYPH_MAX must be up to 255, LCD_GLYPH_NONE is reserved"
+#endif
 
 /* Function Definition --------------------------------*/
 
-#if(LCD_COMMUNICATION == LCD_I2C_COM)
+#if(LCD_COMMUNICATION != LCD_SERIAL_COM)
 /*
  * @brief  Checks if the LCD device is ready.
+ * @param  i2cHandle   I2C bus of the LCD device.
  * @param  deviceAddr  Address of the LCD device.
  * @retval e_Status  Status of the device readiness (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status LCD_IsDeviceReady()
+e_Status LCD_IsDeviceReady(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr)
 {
-    return (HAL_I2C_IsDeviceReady(LCD_I2C_HANDLER, LCD_I2C_ADDRESS, LCD_TRIAL, LCD_TIMEOUT));
+    return (HAL_I2C_IsDeviceReady(i2cHandle, deviceAddr, LCD_TRIAL, LCD_TIMEOUT));
 }
 
 /**
@@ -49,15 +92,69 @@ e_Status LCD_IsDeviceReady()
  * This function uses the HAL I2C Master Transmit function to send data
  * to the LCD over I2C.
  *
+ * @param  i2cHandle I2C bus of the LCD device.
+ * @param  deviceAddr Address of the LCD device.
  * @param  writeDataBuffer Pointer to the data buffer to be transmitted.
  * @param  writeDataSize The size of the data to be transmitted.
  * @return e_Status Returns the status of the transmission.
  */
-e_Status LCD_Transmit(uint8_t *writeDataBuffer, uint8_t writeDataSize)
+e_Status LCD_Transmit(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint8_t *writeDataBuffer, uint16_t writeDataSize)
+{
+    return HAL_I2C_Master_Transmit(i2cHandle, deviceAddr, writeDataBuffer, writeDataSize, LCD_TIMEOUT);
+}
+
+/**
+ * @brief  Receives data from the LCD via I2C.
+ *
+ * This function reads the port of the PCF8574, used for the busy flag of the LCD.
+ *
+ * @param  i2cHandle I2C bus of the LCD device.
+ * @param  deviceAddr Address of the LCD device.
+ * @param  readDataBuffer Pointer to the data buffer to store the read data.
+ * @param  readDataSize The size of the data to be read.
+ * @return e_Status Returns the status of the reception.
+ */
+e_Status LCD_Receive(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint8_t *readDataBuffer, uint16_t readDataSize)
+{
+    return HAL_I2C_Master_Receive(i2cHandle, deviceAddr, readDataBuffer, readDataSize, LCD_TIMEOUT);
+}
+
+#endif /*(LCD_COMMUNICATION != LCD_SERIAL_COM)*/
+
+#if(LCD_COMMUNICATION == LCD_I2C_IT_COM)
+/**
+ * @brief  Starts an interrupt driven transmit of data to the LCD via I2C.
+ *
+ * The buffer must stay valid until LCD_TransmitCompleteCallback() is called.
+ *
+ * @param  i2cHandle I2C bus of the LCD device.
+ * @param  deviceAddr Address of the LCD device.
+ * @param  writeDataBuffer Pointer to the data buffer to be transmitted.
+ * @param  writeDataSize The size of the data to be transmitted.
+ * @return e_Status Returns the status of the start of the transmission.
+ */
+e_Status LCD_TransmitAsync(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint8_t *writeDataBuffer, uint16_t writeDataSize)
+{
+    return HAL_I2C_Master_Transmit_IT(i2cHandle, deviceAddr, writeDataBuffer, writeDataSize);
+}
+
+#elif(LCD_COMMUNICATION == LCD_I2C_DMA_COM)
+/**
+ * @brief  Starts a DMA driven transmit of data to the LCD via I2C.
+ *
+ * The buffer must stay valid until LCD_TransmitCompleteCallback() is called.
+ *
+ * @param  i2cHandle I2C bus of the LCD device.
+ * @param  deviceAddr Address of the LCD device.
+ * @param  writeDataBuffer Pointer to the data buffer to be transmitted.
+ * @param  writeDataSize The size of the data to be transmitted.
+ * @return e_Status Returns the status of the start of the transmission.
+ */
+e_Status LCD_TransmitAsync(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint8_t *writeDataBuffer, uint16_t writeDataSize)
 {
-    return HAL_I2C_Master_Transmit(LCD_I2C_HANDLER, LCD_I2C_ADDRESS, writeDataBuffer, (uint16_t)writeDataSize, LCD_TIMEOUT);
+    return HAL_I2C_Master_Transmit_DMA(i2cHandle, deviceAddr, writeDataBuffer, writeDataSize);
 }
 
-#endif /*(LCD_COMMUNICATION == LCD_I2C_COM)*/
+#endif /*(LCD_COMMUNICATION == LCD_I2C_IT_COM)*/
 
 #endif /* LCD_CFG_H_ */
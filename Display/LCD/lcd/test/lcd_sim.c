@@ -0,0 +1,960 @@
+/**
+ * @file lcd_sim.c
+ * @brief Host simulator of the LCD driver on a model of the PCF8574 and the HD44780
+ *
+ * The model decodes the PCF8574 port bytes of each transmit (enable falling edges, 4-bit
+ * transfers) into the instructions and data of an HD44780 with its DDRAM, CGRAM, address counter
+ * and display shift. The bus runs at 100 kHz, an instruction sent while the HD44780 is still busy
+ * is counted. The checks compare the cells shown by the model with the framebuffer.
+ *
+ * Build and run from the root of the repository:
+ *   gcc -std=c99 -Wall -I Misc -I Display/LCD/lcd/test/stub -I Display/LCD/lcd/src
+ *       Display/LCD/lcd/test/lcd_sim.c Display/LCD/lcd/src/lcd.c -o lcd_sim && ./lcd_sim
+ *
+ * The transmit queue (interrupt driven transmit) is checked by a second build with
+ * -DLCD_COMMUNICATION=0x02 (LCD_I2C_IT_COM), the transfers then complete in the background of the
+ * simulated time, the completion interrupt reads the queue when the last byte is on the bus.
+ *
+ * The exit code is 0 when all the checks pass.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lcd.h>
+
+/* Macro Definition -----------------------------------*/
+#define SIM_BYTE_TIME_US			90.0		/* 100 kHz, 9 bits per byte with the acknowledge */
+#define SIM_START_STOP_US			20.0
+#define SIM_EXEC_SHORT_US			37.0
+#define SIM_EXEC_LONG_US			1520.0
+#define SIM_PANEL_MAX				2u
+#define SIM_DDRAM_SIZE				0x80
+#define SIM_CGRAM_SIZE				0x40
+
+#define SIM_PORT_RS					0x01
+#define SIM_PORT_EN					0x04
+#define SIM_PORT_BACKLIGHT			0x08
+
+#define SIM_UPDATE_COUNT			1000u		/* Dashboard updates */
+#define SIM_STRING_COUNT			200u		/* Strings of the batch test */
+#define SIM_FRAME_COUNT				1000u		/* Frames of the commit test */
+#define SIM_GRAPH_FRAME_COUNT		400u		/* Frames of the bar graph */
+#define SIM_LEVEL_COUNT				6u			/* Bar cell glyphs, 0 to 5 columns */
+#define SIM_ICON_COUNT				5u			/* Rotating icons, after the levels */
+#define SIM_GLYPH_NONE				0xFF
+#define SIM_BATCH_MAX_SIZE			64u			/* LCD_BATCH_MAX_SIZE of lcd_cfg.h */
+#define SIM_ROUND_COUNT				200u		/* Bus rounds of the group commit */
+#define SIM_MARQUEE_STEPS			50u
+#define SIM_QUEUE_SIZE				512u		/* LCD_QUEUE_SIZE of lcd_cfg.h */
+#define SIM_BURST_COUNT				40u			/* Strings of the burst through the transmit queue */
+
+/* Transmit queue, LCD_I2C_IT_COM or LCD_I2C_DMA_COM set by the build */
+#if defined(LCD_COMMUNICATION) && ( (LCD_COMMUNICATION == 0x02) || (LCD_COMMUNICATION == 0x03) )
+#define SIM_ASYNC					1u
+#else
+#define SIM_ASYNC					0u
+#endif
+
+/* Structures -----------------------------------------*/
+
+/* HD44780 behind a PCF8574 */
+typedef struct
+{
+	uint8_t   address;				/* 8-bit write address of the PCF8574 */
+	uint8_t   fourBit;				/* 0 until the function set of the 4-bit mode */
+	uint8_t   lowNibble;			/* 1 when the high nibble of a byte is latched */
+	uint8_t   latched;				/* High nibble of the byte in progress */
+	uint8_t   lastPort;
+	uint8_t   backlight;
+	uint8_t   ddram[SIM_DDRAM_SIZE];
+	uint8_t   cgram[SIM_CGRAM_SIZE];
+	uint8_t   addressCounter;
+	uint8_t   cgramSelected;
+	uint8_t   increment;
+	uint8_t   displayOn;
+	int       shift;				/* Display shift, in columns to the left */
+	double    busyUntil;
+	uint32_t  busyViolationCount;	/* Instructions or data latched while busy */
+	uint32_t  cgramWriteCount;
+}st_SimPanel;
+
+/* Interrupt driven transfer on the bus */
+typedef struct
+{
+	uint8_t      pending;
+	st_SimPanel *panel;
+	uint8_t     *data;				/* Read when the transfer completes */
+	uint16_t     size;
+	double       startTime;
+	double       endTime;
+}st_SimTransfer;
+
+/* Variables ------------------------------------------*/
+I2C_HandleTypeDef hi2c1;
+uint32_t simPrimask = 0u;
+
+static double simTime = 0.0;				/* in us */
+static st_SimPanel panels[SIM_PANEL_MAX];
+static uint8_t panelCount = 0u;
+#if(SIM_ASYNC == 0u)
+static uint8_t glyphBitmap[SIM_LEVEL_COUNT + SIM_ICON_COUNT][LCD_GLYPH_ROWS];
+static uint8_t expectedGlyph[SIM_DDRAM_SIZE];		/* Glyph expected at each DDRAM address */
+#endif
+static st_SimTransfer transfer;
+static uint8_t inInterrupt = 0u;
+static uint8_t failTransfer = 0u;					/* The next transfer ends with a bus error */
+
+/* Static Function Declaration ------------------------*/
+static st_SimPanel* SIM_FindPanel(uint16_t address);
+static void SIM_Execute(st_SimPanel *panel, uint8_t value, uint8_t isData, double latchTime);
+static void SIM_PortWrite(st_SimPanel *panel, const uint8_t *data, uint16_t size, double startTime);
+static void SIM_AddPanel(uint8_t address);
+static uint8_t SIM_Cell(const st_SimPanel *panel, const st_LCDHandle *lcd, uint8_t row, uint8_t col);
+static uint32_t SIM_CheckFrame(const st_SimPanel *panel, const st_LCDHandle *lcd);
+#if(SIM_ASYNC == 1u)
+static int SIM_Async(void);
+#else
+static int SIM_FrameFlush(void);
+static int SIM_Batch(void);
+static int SIM_FrameCommit(void);
+static uint32_t SIM_CheckGlyphs(const st_SimPanel *panel);
+static int SIM_Glyph(void);
+static int SIM_Group(void);
+#endif
+
+/* HAL model ------------------------------------------*/
+
+void SIM_Interrupt(void)
+{
+	st_SimPanel *panel = transfer.panel;
+
+	/* Transfer complete interrupt, not nested and not while masked */
+	if( (transfer.pending == 1u) && (simTime >= transfer.endTime) && (simPrimask == 0u) && (inInterrupt == 0u) )
+	{
+		inInterrupt = 1u;
+		transfer.pending = 0u;
+		if(failTransfer == 1u)
+		{
+			/* Bus error after the first half of the packets */
+			failTransfer = 0u;
+			SIM_PortWrite(panel, transfer.data, (uint16_t)((transfer.size / 2u) & ~(LCD_PACKET_SZ - 1u)), transfer.startTime);
+			LCD_TransmitErrorCallback();
+		}
+		else
+		{
+			SIM_PortWrite(panel, transfer.data, transfer.size, transfer.startTime);
+			LCD_TransmitCompleteCallback();
+		}
+		inInterrupt = 0u;
+	}
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	double endTime = simTime + (Delay * 1000.0);
+
+	/* The transfers completing during the delay are followed by the next ones */
+	while( (transfer.pending == 1u) && (transfer.endTime <= endTime) && (simPrimask == 0u) )
+	{
+		simTime = (transfer.endTime > simTime) ? transfer.endTime : simTime;
+		SIM_Interrupt();
+	}
+
+	simTime = endTime;
+	SIM_Interrupt();
+}
+
+uint32_t HAL_GetTick(void)
+{
+	/* Spinning on the tick costs time */
+	simTime += 1.0;
+	SIM_Interrupt();
+
+	return (uint32_t)(simTime / 1000.0);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+	(void)hi2c; (void)Trials; (void)Timeout;
+	simTime += SIM_BYTE_TIME_US + SIM_START_STOP_US;
+
+	return (SIM_FindPanel(DevAddress) != NULL) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+	st_SimPanel *panel = SIM_FindPanel(DevAddress);
+
+	(void)hi2c; (void)Timeout;
+
+	if(transfer.pending == 1u)
+	{
+		returnValue = HAL_BUSY;
+	}
+	else if(panel != NULL)
+	{
+		SIM_PortWrite(panel, pData, Size, simTime);
+		simTime += ((1u + Size) * SIM_BYTE_TIME_US) + SIM_START_STOP_US;
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)hi2c; (void)DevAddress; (void)Timeout;
+
+	/* Not busy, the busy flag read is not simulated */
+	memset(pData, 0, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+	st_SimPanel *panel = SIM_FindPanel(DevAddress);
+
+	(void)hi2c;
+
+	if(transfer.pending == 1u)
+	{
+		returnValue = HAL_BUSY;
+	}
+	else if(panel != NULL)
+	{
+		transfer.pending = 1u;
+		transfer.panel = panel;
+		transfer.data = pData;
+		transfer.size = Size;
+		transfer.startTime = simTime;
+		transfer.endTime = simTime + ((1u + Size) * SIM_BYTE_TIME_US) + SIM_START_STOP_US;
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	return HAL_I2C_Master_Transmit_IT(hi2c, DevAddress, pData, Size);
+}
+
+/* Static Function Definition -------------------------*/
+
+static st_SimPanel* SIM_FindPanel(uint16_t address)
+{
+	st_SimPanel *panel = NULL;
+
+	for(uint8_t index = 0u; index < panelCount; index++)
+	{
+		if(panels[index].address == address)
+		{
+			panel = &panels[index];
+		}
+	}
+
+	return panel;
+}
+
+static void SIM_Execute(st_SimPanel *panel, uint8_t value, uint8_t isData, double latchTime)
+{
+	double execTime = SIM_EXEC_SHORT_US;
+
+	if(latchTime < panel->busyUntil)
+	{
+		panel->busyViolationCount++;
+	}
+
+	if(isData == 1u)
+	{
+		if(panel->cgramSelected == 1u)
+		{
+			panel->cgram[panel->addressCounter & (SIM_CGRAM_SIZE - 1u)] = value;
+			panel->cgramWriteCount++;
+			panel->addressCounter = (panel->addressCounter + 1u) & (SIM_CGRAM_SIZE - 1u);
+		}
+		else
+		{
+			panel->ddram[panel->addressCounter] = value;
+			if(panel->increment == 1u)
+			{
+				panel->addressCounter = (panel->addressCounter == 0x27) ? 0x40 : ((panel->addressCounter == 0x67) ? 0x00 : (panel->addressCounter + 1u));
+			}
+			else
+			{
+				panel->addressCounter = (panel->addressCounter == 0x00) ? 0x67 : ((panel->addressCounter == 0x40) ? 0x27 : (panel->addressCounter - 1u));
+			}
+		}
+	}
+	else if( (value & LCD_SET_DDRAM_ADDR) != 0u )
+	{
+		panel->addressCounter = value & 0x7F;
+		panel->cgramSelected = 0u;
+	}
+	else if( (value & LCD_SET_CGRAM_ADDR) != 0u )
+	{
+		panel->addressCounter = value & 0x3F;
+		panel->cgramSelected = 1u;
+	}
+	else if( (value & LCD_FUNC_SET) != 0u )
+	{
+		panel->fourBit = ((value & LCD_8BITMODE) == 0u) ? 1u : 0u;
+		panel->lowNibble = 0u;
+	}
+	else if( (value & LCD_DISP_CURSOR_SHIFT) != 0u )
+	{
+		if( (value & LCD_DISPLAY_SHIFT) != 0u )
+		{
+			panel->shift += ((value & LCD_SHIFT_RIGHT) != 0u) ? -1 : 1;
+			panel->shift = (panel->shift + LCD_LINE_LENGTH) % LCD_LINE_LENGTH;
+		}
+	}
+	else if( (value & LCD_DISPLAY_CONTROL) != 0u )
+	{
+		panel->displayOn = ((value & LCD_DISPLAY_ON) != 0u) ? 1u : 0u;
+	}
+	else if( (value & LCD_ENTRY_MODE_SET) != 0u )
+	{
+		panel->increment = ((value & LCD_INCREMENT) != 0u) ? 1u : 0u;
+	}
+	else if( (value & LCD_RET_HOME) != 0u )
+	{
+		panel->addressCounter = 0x00;
+		panel->cgramSelected = 0u;
+		panel->shift = 0;
+		execTime = SIM_EXEC_LONG_US;
+	}
+	else if(value == LCD_CLEAR_DISPLAY)
+	{
+		memset(panel->ddram, ' ', sizeof(panel->ddram));
+		panel->addressCounter = 0x00;
+		panel->cgramSelected = 0u;
+		panel->shift = 0;
+		panel->increment = 1u;
+		execTime = SIM_EXEC_LONG_US;
+	}
+	else
+	{
+		/* No instruction */
+	}
+
+	panel->busyUntil = latchTime + execTime;
+}
+
+static void SIM_PortWrite(st_SimPanel *panel, const uint8_t *data, uint16_t size, double startTime)
+{
+	double latchTime = 0.0;
+
+	for(uint16_t index = 0u; index < size; index++)
+	{
+		latchTime = startTime + ((2u + index) * SIM_BYTE_TIME_US);
+		panel->backlight = ((data[index] & SIM_PORT_BACKLIGHT) != 0u) ? 1u : 0u;
+
+		/* The HD44780 latches the data pins on the falling edge of the enable */
+		if( ((panel->lastPort & SIM_PORT_EN) != 0u) && ((data[index] & SIM_PORT_EN) == 0u) )
+		{
+			if(panel->fourBit == 0u)
+			{
+				SIM_Execute(panel, panel->lastPort & 0xF0, 0u, latchTime);
+			}
+			else if(panel->lowNibble == 0u)
+			{
+				panel->latched = panel->lastPort & 0xF0;
+				panel->lowNibble = 1u;
+
+				/* The busy check is made at the start of the transfer */
+				if(latchTime < panel->busyUntil)
+				{
+					panel->busyViolationCount++;
+					panel->busyUntil = 0.0;
+				}
+			}
+			else
+			{
+				panel->lowNibble = 0u;
+				SIM_Execute(panel, panel->latched | (panel->lastPort >> 4u), ((panel->lastPort & SIM_PORT_RS) != 0u) ? 1u : 0u, latchTime);
+			}
+		}
+
+		panel->lastPort = data[index];
+	}
+}
+
+static void SIM_AddPanel(uint8_t address)
+{
+	st_SimPanel *panel = &panels[panelCount];
+
+	memset(panel, 0, sizeof(*panel));
+	memset(panel->ddram, 0xA5, sizeof(panel->ddram));	/* Garbage until cleared */
+	memset(panel->cgram, 0xA5, sizeof(panel->cgram));
+	panel->address = address;
+	panel->increment = 1u;
+	panelCount++;
+}
+
+static uint8_t SIM_Cell(const st_SimPanel *panel, const st_LCDHandle *lcd, uint8_t row, uint8_t col)
+{
+	uint8_t address = lcd->rowOffset[row];
+	uint8_t line = address & LCD_ROW_1;
+	uint8_t column = (uint8_t)(((address & ~LCD_ROW_1) + col + panel->shift) % LCD_LINE_LENGTH);
+
+	return panel->ddram[line | column];
+}
+
+static uint32_t SIM_CheckFrame(const st_SimPanel *panel, const st_LCDHandle *lcd)
+{
+	uint32_t badCount = 0u;
+
+	for(uint8_t row = 0u; row < lcd->rowCount; row++)
+	{
+		for(uint8_t col = 0u; col < lcd->charCount; col++)
+		{
+			badCount += (SIM_Cell(panel, lcd, row, col) != lcd->frame.frameBuffer[row][col]);
+		}
+	}
+
+	return badCount;
+}
+
+#if(SIM_ASYNC == 0u)
+static int SIM_FrameFlush(void)
+{
+	int failCount = 0;
+	st_LCDHandle lcd;
+	st_LCDTransactionStatistics transactions;
+	uint32_t badCount = 0u;
+	uint32_t update = 0u;
+	uint32_t seconds = 0u;
+	uint8_t clearCmd = LCD_CLEAR_DISPLAY;
+	char line[LCD_CHAR_MAX + 1u];
+
+	printf("Framebuffer: %u updates of a 16x2 dashboard (temperature, humidity, pressure, clock)\n", SIM_UPDATE_COUNT);
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	failCount += (LCD_Init(&lcd, &hi2c1, LCD_I2C_ADDRESS, 2u, 16u) != STATUS_OK);
+
+	/* Dirty cells only */
+	LCD_ResetTransactionStatistics(&lcd);
+	for(update = 0u; update < SIM_UPDATE_COUNT; update++)
+	{
+		seconds = 12u * 3600u + update;
+		LCD_FramePrintf(&lcd, 0u, 0u, "T:%.1kC H:%2u%%", 215 + (int)((update / 7u) % 20u), 40u + (update / 13u) % 10u);
+		LCD_FramePrintf(&lcd, 1u, 0u, "%6lu %02u:%02u:%02u", 101300uL + (update / 5u) % 50u, seconds / 3600u, (seconds / 60u) % 60u, seconds % 60u);
+		failCount += (LCD_Flush(&lcd) != STATUS_OK);
+		badCount += SIM_CheckFrame(&panels[0], &lcd);
+	}
+
+	LCD_GetTransactionStatistics(&lcd, &transactions);
+	printf("  dirty cells:  %.1f transmits, %.1f bytes per update\n", (double)transactions.transmitCount / SIM_UPDATE_COUNT, (double)transactions.byteCount / SIM_UPDATE_COUNT);
+
+	/* Whole screen rewritten for each update */
+	LCD_ResetTransactionStatistics(&lcd);
+	for(update = 0u; update < SIM_UPDATE_COUNT; update++)
+	{
+		for(uint8_t row = 0u; row < lcd.rowCount; row++)
+		{
+			memcpy(line, lcd.frame.frameBuffer[row], lcd.charCount);
+			LCD_SetCursor(&lcd, row, 0u);
+			LCD_SendString(&lcd, line, lcd.charCount);
+		}
+	}
+
+	LCD_GetTransactionStatistics(&lcd, &transactions);
+	printf("  whole screen: %.1f transmits, %.1f bytes per update\n", (double)transactions.transmitCount / SIM_UPDATE_COUNT, (double)transactions.byteCount / SIM_UPDATE_COUNT);
+
+	/* The direct writes are followed: the framebuffer content is sent back over them */
+	LCD_FrameWrite(&lcd, 0u, 0u, "HELLO", 5u);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	LCD_SetCursor(&lcd, 0u, 0u);
+	LCD_SendString(&lcd, "WORLD", 5u);
+	LCD_FrameWrite(&lcd, 0u, 0u, "HELLO", 5u);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	badCount += SIM_CheckFrame(&panels[0], &lcd);
+
+	LCD_SetCursor(&lcd, 1u, 4u);
+	LCD_Printf(&lcd, "%d", -12345);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	badCount += SIM_CheckFrame(&panels[0], &lcd);
+
+	LCD_SendCommands(&lcd, &clearCmd, 1u);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	badCount += SIM_CheckFrame(&panels[0], &lcd);
+
+	printf("  cells different from the framebuffer %u, instructions while busy %u\n", badCount, panels[0].busyViolationCount);
+	failCount += (int)(badCount + panels[0].busyViolationCount);
+
+	return failCount;
+}
+
+static int SIM_Batch(void)
+{
+	int failCount = 0;
+	st_LCDHandle lcd;
+	st_LCDTransactionStatistics transactions;
+	char text[LCD_LINE_LENGTH];
+	uint8_t commands[LCD_LINE_LENGTH];
+	uint32_t badCount = 0u;
+	uint32_t expected = 0u;
+	uint8_t size = 0u;
+	double startTime = 0.0;
+	double batchTime = 0.0;
+	double charTime = 0.0;
+
+	printf("Batch: %u strings of 16 characters, then random strings and command lists\n", SIM_STRING_COUNT);
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	failCount += (LCD_Init(&lcd, &hi2c1, LCD_I2C_ADDRESS, 2u, 16u) != STATUS_OK);
+
+	/* A 16 character string is one transmit of 64 bytes */
+	LCD_ResetTransactionStatistics(&lcd);
+	startTime = simTime;
+	for(uint32_t string = 0u; string < SIM_STRING_COUNT; string++)
+	{
+		memset(text, 'A' + (string % 26u), 16u);
+		LCD_SetCursor(&lcd, string % 2u, 0u);
+		failCount += (LCD_SendString(&lcd, text, 16u) != STATUS_OK);
+		badCount += (memcmp(&panels[0].ddram[lcd.rowOffset[string % 2u]], text, 16u) != 0);
+	}
+
+	batchTime = simTime - startTime;
+	LCD_GetTransactionStatistics(&lcd, &transactions);
+	failCount += (transactions.transmitCount != (2u * SIM_STRING_COUNT));
+
+	/* One character per transmit */
+	startTime = simTime;
+	for(uint32_t string = 0u; string < SIM_STRING_COUNT; string++)
+	{
+		memset(text, 'a' + (string % 26u), 16u);
+		LCD_SetCursor(&lcd, string % 2u, 0u);
+		for(uint8_t index = 0u; index < 16u; index++)
+		{
+			failCount += (LCD_SendString(&lcd, &text[index], 1u) != STATUS_OK);
+		}
+
+		badCount += (memcmp(&panels[0].ddram[lcd.rowOffset[string % 2u]], text, 16u) != 0);
+	}
+
+	charTime = simTime - startTime;
+	printf("  batched:           %.0f characters per second\n", (16.0 * SIM_STRING_COUNT) / (batchTime / 1e6));
+	printf("  one per transmit:  %.0f characters per second\n", (16.0 * SIM_STRING_COUNT) / (charTime / 1e6));
+	failCount += (batchTime >= charTime);
+
+	/* Random sizes: one transmit per SIM_BATCH_MAX_SIZE bytes */
+	for(uint32_t string = 0u; string < SIM_STRING_COUNT; string++)
+	{
+		size = (uint8_t)(1u + (rand() % LCD_LINE_LENGTH));
+		for(uint8_t index = 0u; index < size; index++)
+		{
+			text[index] = (char)(' ' + (rand() % 90));
+			commands[index] = LCD_SET_DDRAM_ADDR | (uint8_t)(rand() % LCD_LINE_LENGTH);
+		}
+
+		LCD_SetCursor(&lcd, 0u, 0u);
+		LCD_ResetTransactionStatistics(&lcd);
+		failCount += (LCD_SendString(&lcd, text, size) != STATUS_OK);
+		LCD_GetTransactionStatistics(&lcd, &transactions);
+		expected = ((size * LCD_PACKET_SZ) + SIM_BATCH_MAX_SIZE - 1u) / SIM_BATCH_MAX_SIZE;
+		badCount += (transactions.transmitCount != expected) + (memcmp(panels[0].ddram, text, size) != 0);
+
+		LCD_ResetTransactionStatistics(&lcd);
+		failCount += (LCD_SendCommands(&lcd, commands, size) != STATUS_OK);
+		LCD_GetTransactionStatistics(&lcd, &transactions);
+		badCount += (transactions.transmitCount != expected) + (panels[0].addressCounter != (commands[size - 1u] & 0x7F));
+	}
+
+	printf("  wrong transmit counts or DDRAM content %u, instructions while busy %u\n", badCount, panels[0].busyViolationCount);
+	failCount += (int)(badCount + panels[0].busyViolationCount);
+
+	return failCount;
+}
+
+static int SIM_FrameCommit(void)
+{
+	int failCount = 0;
+	st_LCDHandle lcd;
+	st_LCDTransactionStatistics transactions;
+	uint32_t badCount = 0u;
+	uint32_t tornCount = 0u;
+	uint32_t transmitCount = 0u;
+	uint32_t changeCount = 0u;
+	uint8_t row = 0u;
+	uint8_t col = 0u;
+	char cell = ' ';
+	double startTime = 0.0;
+	double commitTime = 0.0;
+	double rowTime = 0.0;
+
+	printf("Frame commit: %u random frames of a 20x4 LCD\n", SIM_FRAME_COUNT);
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	failCount += (LCD_Init(&lcd, &hi2c1, LCD_I2C_ADDRESS, 4u, 20u) != STATUS_OK);
+	LCD_ResetTransactionStatistics(&lcd);
+	startTime = simTime;
+
+	for(uint32_t frame = 0u; frame < SIM_FRAME_COUNT; frame++)
+	{
+		/* From a few cells to the whole frame */
+		changeCount = ((frame % 10u) == 0u) ? 80u : (1u + (rand() % 12u));
+		for(uint32_t change = 0u; change < changeCount; change++)
+		{
+			row = (uint8_t)(rand() % 4u);
+			col = (uint8_t)(rand() % 20u);
+			cell = (char)('0' + (rand() % 75));
+			LCD_FrameWrite(&lcd, row, col, &cell, 1u);
+		}
+
+		LCD_GetTransactionStatistics(&lcd, &transactions);
+		transmitCount = transactions.transmitCount;
+		failCount += (LCD_FrameCommit(&lcd) != STATUS_OK);
+		LCD_GetTransactionStatistics(&lcd, &transactions);
+		tornCount += ((transactions.transmitCount - transmitCount) > 1u);
+		badCount += SIM_CheckFrame(&panels[0], &lcd);
+	}
+
+	commitTime = simTime - startTime;
+	printf("  commit:          %.1f frames per second, %.1f bytes per frame\n", SIM_FRAME_COUNT / (commitTime / 1e6), (double)transactions.byteCount / SIM_FRAME_COUNT);
+
+	/* Each row by LCD_SetCursor() and LCD_SendString() */
+	LCD_ResetTransactionStatistics(&lcd);
+	startTime = simTime;
+	for(uint32_t frame = 0u; frame < SIM_FRAME_COUNT; frame++)
+	{
+		for(row = 0u; row < lcd.rowCount; row++)
+		{
+			LCD_SetCursor(&lcd, row, 0u);
+			LCD_SendString(&lcd, (char*)lcd.frame.frameBuffer[row], lcd.charCount);
+		}
+	}
+
+	rowTime = simTime - startTime;
+	LCD_GetTransactionStatistics(&lcd, &transactions);
+	printf("  row by row:      %.1f frames per second, %.1f transmits per frame\n", SIM_FRAME_COUNT / (rowTime / 1e6), (double)transactions.transmitCount / SIM_FRAME_COUNT);
+	printf("  frames in more than one transmit %u, cells different from the framebuffer %u, instructions while busy %u\n", tornCount, badCount, panels[0].busyViolationCount);
+	failCount += (int)(tornCount + badCount + panels[0].busyViolationCount);
+
+	return failCount;
+}
+
+static uint32_t SIM_CheckGlyphs(const st_SimPanel *panel)
+{
+	uint32_t badCount = 0u;
+	uint8_t charCode = 0u;
+
+	for(uint8_t address = 0u; address < SIM_DDRAM_SIZE; address++)
+	{
+		charCode = panel->ddram[address];
+		if( (expectedGlyph[address] != SIM_GLYPH_NONE) &&
+			((charCode >= LCD_CGRAM_SLOTS) || (memcmp(&panel->cgram[charCode * LCD_GLYPH_ROWS], glyphBitmap[expectedGlyph[address]], LCD_GLYPH_ROWS) != 0)) )
+		{
+			badCount++;
+		}
+	}
+
+	return badCount;
+}
+
+static int SIM_Glyph(void)
+{
+	int failCount = 0;
+	st_LCDHandle lcd;
+	st_GlyphStatistics glyphs;
+	e_Status status = STATUS_OK;
+	char text[2u * LCD_CGRAM_SLOTS + 2u];
+	uint8_t clearCmd = LCD_CLEAR_DISPLAY;
+	uint8_t shown[SIM_DDRAM_SIZE];
+	uint32_t badCount = 0u;
+	uint32_t level = 0u;
+	uint8_t fill = 0u;
+
+	printf("Glyphs: %u frames of a 16 cell bar graph and 2 rotating icons, %u glyphs in %u CGRAM slots\n",
+		   SIM_GRAPH_FRAME_COUNT, SIM_LEVEL_COUNT + SIM_ICON_COUNT, LCD_CGRAM_SLOTS);
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	failCount += (LCD_Init(&lcd, &hi2c1, LCD_I2C_ADDRESS, 2u, 16u) != STATUS_OK);
+
+	/* Bar cells filled from the left, then icons */
+	for(uint8_t glyph = 0u; glyph < (SIM_LEVEL_COUNT + SIM_ICON_COUNT); glyph++)
+	{
+		for(uint8_t row = 0u; row < LCD_GLYPH_ROWS; row++)
+		{
+			glyphBitmap[glyph][row] = (glyph < SIM_LEVEL_COUNT) ? (uint8_t)((0x1F << (5u - glyph)) & 0x1F) : (uint8_t)(((glyph * 37u) + (row * 11u)) & 0x1F);
+		}
+
+		failCount += (LCD_RegisterGlyph(glyph, glyphBitmap[glyph]) != STATUS_OK);
+	}
+
+	memset(expectedGlyph, SIM_GLYPH_NONE, sizeof(expectedGlyph));
+	LCD_ResetGlyphStatistics(&lcd);
+	for(uint32_t frame = 0u; frame < SIM_GRAPH_FRAME_COUNT; frame++)
+	{
+		/* Triangle from 0 to 80 columns */
+		level = (frame * 3u) % 160u;
+		level = (level > 80u) ? (160u - level) : level;
+		for(uint8_t col = 0u; col < 16u; col++)
+		{
+			fill = (level > (col * 5u)) ? (uint8_t)(((level - (col * 5u)) > 5u) ? 5u : (level - (col * 5u))) : 0u;
+			text[0] = LCD_GLYPH_ESCAPE;
+			text[1] = (char)fill;
+			failCount += (LCD_FrameWrite(&lcd, 0u, col, text, 2u) != STATUS_OK);
+			expectedGlyph[lcd.rowOffset[0] + col] = fill;
+		}
+
+		text[1] = (char)(SIM_LEVEL_COUNT + ((frame / 10u) % SIM_ICON_COUNT));
+		failCount += (LCD_FrameWrite(&lcd, 1u, 0u, text, 2u) != STATUS_OK);
+		expectedGlyph[lcd.rowOffset[1]] = (uint8_t)text[1];
+		text[1] = (char)(SIM_LEVEL_COUNT + (((frame / 15u) + 2u) % SIM_ICON_COUNT));
+		failCount += (LCD_FrameWrite(&lcd, 1u, 15u, text, 2u) != STATUS_OK);
+		expectedGlyph[lcd.rowOffset[1] + 15u] = (uint8_t)text[1];
+		LCD_FramePrintf(&lcd, 1u, 6u, "%3u%%", (level * 100u) / 80u);
+
+		failCount += (LCD_Flush(&lcd) != STATUS_OK);
+		badCount += SIM_CheckGlyphs(&panels[0]);
+	}
+
+	LCD_GetGlyphStatistics(&lcd, &glyphs);
+	printf("  %u uploads, %.1f CGRAM bytes per frame (%u written in the model), %u hits\n", glyphs.uploadCount,
+		   (double)glyphs.cgramWriteCount / SIM_GRAPH_FRAME_COUNT, panels[0].cgramWriteCount, glyphs.hitCount);
+	failCount += (glyphs.cgramWriteCount != panels[0].cgramWriteCount);
+
+	/* Every slot on the LCD by the direct path, a ninth glyph is refused */
+	LCD_FrameClear(&lcd);
+	failCount += (LCD_SendCommands(&lcd, &clearCmd, 1u) != STATUS_OK);
+	memset(expectedGlyph, SIM_GLYPH_NONE, sizeof(expectedGlyph));
+	for(uint8_t glyph = 0u; glyph < LCD_CGRAM_SLOTS; glyph++)
+	{
+		text[2u * glyph] = LCD_GLYPH_ESCAPE;
+		text[(2u * glyph) + 1u] = (char)(SIM_ICON_COUNT - 2u + glyph);
+		expectedGlyph[glyph] = SIM_ICON_COUNT - 2u + glyph;
+	}
+
+	LCD_SetCursor(&lcd, 0u, 0u);
+	failCount += (LCD_SendString(&lcd, text, 2u * LCD_CGRAM_SLOTS) != STATUS_OK);
+	text[1] = 0u;
+	LCD_SetCursor(&lcd, 1u, 0u);
+	status = LCD_SendString(&lcd, text, 2u);
+	failCount += (status != STATUS_BUSY);
+	badCount += SIM_CheckGlyphs(&panels[0]);
+
+	/* Nine glyphs in one string, the part sent before the refusal stays consistent */
+	failCount += (LCD_SendCommands(&lcd, &clearCmd, 1u) != STATUS_OK);
+	memset(expectedGlyph, SIM_GLYPH_NONE, sizeof(expectedGlyph));
+	for(uint8_t glyph = 0u; glyph <= LCD_CGRAM_SLOTS; glyph++)
+	{
+		text[2u * glyph] = LCD_GLYPH_ESCAPE;
+		text[(2u * glyph) + 1u] = (char)glyph;
+	}
+
+	status = LCD_SendString(&lcd, text, 2u * (LCD_CGRAM_SLOTS + 1u));
+	failCount += (status != STATUS_BUSY);
+	for(uint8_t glyph = 0u; glyph <= LCD_CGRAM_SLOTS; glyph++)
+	{
+		expectedGlyph[glyph] = (panels[0].ddram[glyph] < LCD_CGRAM_SLOTS) ? glyph : SIM_GLYPH_NONE;
+	}
+
+	badCount += SIM_CheckGlyphs(&panels[0]);
+
+	/* The glyphs believed in the CGRAM are the ones written */
+	memcpy(shown, panels[0].ddram, sizeof(shown));
+	LCD_SetCursor(&lcd, 1u, 0u);
+	failCount += (LCD_SendString(&lcd, &text[2], 2u * (LCD_CGRAM_SLOTS - 1u)) != STATUS_OK);
+	for(uint8_t glyph = 1u; glyph < LCD_CGRAM_SLOTS; glyph++)
+	{
+		expectedGlyph[lcd.rowOffset[1] + glyph - 1u] = glyph;
+	}
+
+	badCount += SIM_CheckGlyphs(&panels[0]);
+	badCount += (memcmp(shown, panels[0].ddram, lcd.rowOffset[1]) != 0);
+
+	/* Every slot in the framebuffer, a glyph of another cell is refused and the LCD is unchanged */
+	LCD_FrameClear(&lcd);
+	failCount += (LCD_SendCommands(&lcd, &clearCmd, 1u) != STATUS_OK);
+	memset(expectedGlyph, SIM_GLYPH_NONE, sizeof(expectedGlyph));
+	for(uint8_t glyph = 0u; glyph < LCD_CGRAM_SLOTS; glyph++)
+	{
+		text[0] = LCD_GLYPH_ESCAPE;
+		text[1] = (char)(glyph + 2u);
+		failCount += (LCD_FrameWrite(&lcd, 0u, glyph, text, 2u) != STATUS_OK);
+		expectedGlyph[glyph] = glyph + 2u;
+	}
+
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	memcpy(shown, panels[0].ddram, sizeof(shown));
+	text[1] = 0u;
+	failCount += (LCD_FrameWrite(&lcd, 1u, 0u, text, 2u) != STATUS_BUSY);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	badCount += SIM_CheckGlyphs(&panels[0]) + SIM_CheckFrame(&panels[0], &lcd);
+	badCount += (memcmp(shown, panels[0].ddram, lcd.rowOffset[1]) != 0);
+
+	printf("  glyph cells wrong on the LCD %u, instructions while busy %u\n", badCount, panels[0].busyViolationCount);
+	failCount += (int)(badCount + panels[0].busyViolationCount);
+
+	return failCount;
+}
+
+static int SIM_Group(void)
+{
+	int failCount = 0;
+	st_LCDHandle status;
+	st_LCDHandle menu;
+	st_LCDHandle *lcdList[2u] = {&status, &menu};
+	st_LCDTransactionStatistics transactions[2u];
+	st_MarqueeStatistics marquee;
+	const uint8_t offRowOffset[2u] = {0x04, 0x44};
+	const uint8_t lineRowOffset[2u] = {LCD_ROW_0, LCD_ROW_1};
+	uint32_t badCount = 0u;
+	uint32_t tornCount = 0u;
+	uint8_t lcdIndex = 0u;
+	char cell = ' ';
+
+	printf("Group commit: %u bus rounds of a 16x2 and a 20x4 LCD on one bus\n", SIM_ROUND_COUNT);
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	SIM_AddPanel(0x40);
+	failCount += (LCD_Init(&status, &hi2c1, LCD_I2C_ADDRESS, 2u, 16u) != STATUS_OK);
+	failCount += (LCD_Init(&menu, &hi2c1, 0x40, 4u, 20u) != STATUS_OK);
+
+	for(uint32_t round = 0u; round < SIM_ROUND_COUNT; round++)
+	{
+		for(uint32_t change = 0u; change < 8u; change++)
+		{
+			lcdIndex = (uint8_t)(rand() % 2u);
+			cell = (char)('0' + (rand() % 75));
+			LCD_FrameWrite(lcdList[lcdIndex], (uint8_t)(rand() % lcdList[lcdIndex]->rowCount), (uint8_t)(rand() % lcdList[lcdIndex]->charCount), &cell, 1u);
+		}
+
+		LCD_ResetTransactionStatistics(&status);
+		LCD_ResetTransactionStatistics(&menu);
+		failCount += (LCD_FrameCommitGroup(lcdList, 2u) != STATUS_OK);
+		LCD_GetTransactionStatistics(&status, &transactions[0]);
+		LCD_GetTransactionStatistics(&menu, &transactions[1]);
+		tornCount += (transactions[0].transmitCount > 1u) + (transactions[1].transmitCount > 1u);
+		badCount += SIM_CheckFrame(&panels[0], &status) + SIM_CheckFrame(&panels[1], &menu);
+	}
+
+	/* The display shift moves whole DDRAM lines, the rows must start them */
+	failCount += (LCD_MarqueeSetText(&menu, 0u, "Menu marquee", 12u) != STATUS_OK);
+	failCount += (LCD_MarqueeStart(&menu, 300u) != STATUS_NOT_OK);
+	failCount += (LCD_SetRowOffsets(&status, offRowOffset) != STATUS_OK);
+	failCount += (LCD_MarqueeSetText(&status, 0u, "Status marquee", 14u) != STATUS_OK);
+	failCount += (LCD_MarqueeStart(&status, 300u) != STATUS_NOT_OK);
+	failCount += (LCD_SetRowOffsets(&status, lineRowOffset) != STATUS_OK);
+	failCount += (LCD_MarqueeStart(&status, 300u) != STATUS_OK);
+	for(uint32_t step = 0u; step < SIM_MARQUEE_STEPS; step++)
+	{
+		HAL_Delay(300u);
+		failCount += (LCD_MarqueeProcess(&status) != STATUS_OK);
+	}
+
+	LCD_GetMarqueeStatistics(&status, &marquee);
+	badCount += (marquee.stepCount != SIM_MARQUEE_STEPS) + (panels[0].shift != (int)(SIM_MARQUEE_STEPS % LCD_LINE_LENGTH));
+	badCount += (memcmp(&panels[0].ddram[LCD_ROW_0], "Status marquee", 14u) != 0) + (panels[1].shift != 0);
+	failCount += (LCD_MarqueeStop(&status) != STATUS_OK);
+
+	printf("  LCD frames in more than one transmit %u, wrong cells or marquee steps %u, instructions while busy %u\n",
+		   tornCount, badCount, panels[0].busyViolationCount + panels[1].busyViolationCount);
+	failCount += (int)(tornCount + badCount + panels[0].busyViolationCount + panels[1].busyViolationCount);
+
+	return failCount;
+}
+
+#else
+static int SIM_Async(void)
+{
+	int failCount = 0;
+	st_LCDHandle lcd;
+	st_LCDTransactionStatistics transactions;
+	char text[LCD_LINE_LENGTH];
+	char lastText[2u][16u];
+	uint32_t badCount = 0u;
+	uint32_t byteCount = 0u;
+	double startTime = 0.0;
+	double returnTime = 0.0;
+
+	printf("Transmit queue: interrupt driven transfers\n");
+	panelCount = 0u;
+	SIM_AddPanel(LCD_I2C_ADDRESS);
+	failCount += (LCD_Init(&lcd, &hi2c1, LCD_I2C_ADDRESS, 2u, 16u) != STATUS_OK);
+	failCount += (LCD_WaitComplete() != STATUS_OK);
+
+	/* The flush returns while the frame is on the bus */
+	LCD_FramePrintf(&lcd, 0u, 0u, "Queued %5u", 12345u);
+	LCD_FramePrintf(&lcd, 1u, 0u, "in the background");
+	startTime = simTime;
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	returnTime = simTime - startTime;
+	badCount += (transfer.pending != 1u) + (LCD_IsBusy() != 1u) + (SIM_CheckFrame(&panels[0], &lcd) == 0u);
+	failCount += (LCD_WaitComplete() != STATUS_OK);
+	badCount += SIM_CheckFrame(&panels[0], &lcd);
+	printf("  flush returned after %.0f us, on the LCD after %.0f us\n", returnTime, simTime - startTime);
+
+	/* Burst larger than the queue, the writes wait for room and the buffers are reused */
+	LCD_ResetTransactionStatistics(&lcd);
+	startTime = simTime;
+	for(uint32_t string = 0u; string < SIM_BURST_COUNT; string++)
+	{
+		for(uint8_t index = 0u; index < 16u; index++)
+		{
+			text[index] = (char)('A' + ((string + index) % 26u));
+		}
+
+		memcpy(lastText[string % 2u], text, 16u);
+		LCD_SetCursor(&lcd, string % 2u, 0u);
+		failCount += (LCD_SendString(&lcd, text, 16u) != STATUS_OK);
+	}
+
+	returnTime = simTime - startTime;
+	failCount += (LCD_WaitComplete() != STATUS_OK);
+	LCD_GetTransactionStatistics(&lcd, &transactions);
+	byteCount = transactions.byteCount;
+	badCount += (byteCount <= SIM_QUEUE_SIZE);
+	badCount += (memcmp(&panels[0].ddram[lcd.rowOffset[0]], lastText[0], 16u) != 0) + (memcmp(&panels[0].ddram[lcd.rowOffset[1]], lastText[1], 16u) != 0);
+	printf("  burst of %u bytes in %u transmits, the writes returned after %.1f ms, on the LCD after %.1f ms\n", byteCount, transactions.transmitCount, returnTime / 1000.0, (simTime - startTime) / 1000.0);
+
+	/* A bus error drops the queue, reported once, the next flush sends the whole frame again */
+	LCD_FramePrintf(&lcd, 0u, 0u, "Bus error %5u", 54321u);
+	LCD_FramePrintf(&lcd, 1u, 0u, "dropped frame   ");
+	failTransfer = 1u;
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	failCount += (LCD_WaitComplete() != STATUS_NOT_OK);
+	failCount += (LCD_WaitComplete() != STATUS_OK);
+	badCount += (SIM_CheckFrame(&panels[0], &lcd) == 0u);
+	failCount += (LCD_Flush(&lcd) != STATUS_OK);
+	failCount += (LCD_WaitComplete() != STATUS_OK);
+	badCount += SIM_CheckFrame(&panels[0], &lcd);
+
+	printf("  wrong queue states or LCD content %u, instructions while busy %u\n", badCount, panels[0].busyViolationCount);
+	failCount += (int)(badCount + panels[0].busyViolationCount);
+
+	return failCount;
+}
+#endif
+
+/* Function Definition --------------------------------*/
+
+int main(void)
+{
+	int failCount = 0;
+
+	srand(7u);
+#if(SIM_ASYNC == 1u)
+	failCount += SIM_Async();
+#else
+	failCount += SIM_FrameFlush();
+	failCount += SIM_Batch();
+	failCount += SIM_FrameCommit();
+	failCount += SIM_Glyph();
+	failCount += SIM_Group();
+#endif
+	printf("%s\n", (failCount == 0) ? "PASS" : "FAIL");
+
+	return (failCount == 0) ? 0 : 1;
+}
@@ -15,6 +15,10 @@
 #include <stm32f0xx_hal.h>
 
 #define COMMON_DELAY(x)						( HAL_Delay(x) ) /* For STM32 */
+#define COMMON_GET_TICK()					( HAL_GetTick() ) /* For STM32, millisecond tick */
+#define COMMON_MEMORY_BARRIER()				( __DMB() ) /* For STM32, orders the memory accesses (CMSIS) */
+#define COMMON_ENTER_CRITICAL(state)		do { (state) = __get_PRIMASK(); __disable_irq(); } while(0) /* For STM32, masks the interrupts (CMSIS) */
+#define COMMON_EXIT_CRITICAL(state)			( __set_PRIMASK(state) ) /* For STM32, restores the interrupt mask saved by COMMON_ENTER_CRITICAL() */
 #define CONVERT_8BITS_TO_16BITS(x,y)		( (x << 8) | (y) )
 
 #define POWER_OF_2(x)						( 1 << x )
@@ -0,0 +1,48 @@
+/**
+ * @file crc8.h
+ * @brief Table driven CRC-8 calculation
+ *
+ * CRC-8 with polynomial 0x31 (x^8 + x^5 + x^4 + 1) and initial value 0xFF, no reflection and
+ * no final XOR, as used by the AHT2x and SHT sensors. CRC8_Calculate() of {0xBE, 0xEF} is 0x92.
+ *
+ * @date 2026-10-16
+ * @author jainr
+ */
+
+#ifndef CRC8_H_
+#define CRC8_H_
+
+/* Includes -------------------------------------------*/
+#include <stdint.h>
+
+/* Macro Definition -----------------------------------*/
+#define CRC8_POLYNOMIAL						0x31
+#define CRC8_INIT							0xFF
+
+#define CRC8_TABLE_FULL						0x00	/* 256 bytes table, one lookup per byte */
+#define CRC8_TABLE_NIBBLE					0x01	/* 16 bytes table, two lookups per byte, for flash constrained parts */
+
+/* Select the table of the CRC calculation, can be overridden from the build flags */
+#ifndef CRC8_TABLE_TYPE
+#define CRC8_TABLE_TYPE						CRC8_TABLE_FULL
+#endif
+
+#if( (CRC8_TABLE_TYPE != CRC8_TABLE_FULL) && (CRC8_TABLE_TYPE != CRC8_TABLE_NIBBLE) )
+#error "Invalid CRC8_TABLE_TYPE, use CRC8_TABLE_FULL or CRC8_TABLE_NIBBLE"
+#endif
+
+/* Function Declaration -------------------------------*/
+
+/**
+ * @brief Calculates the CRC-8 of a data buffer.
+ *
+ * @param[in] data Pointer to the data.
+ * @param[in] length Number of bytes of the data.
+ * @param[in] crcInit Initial value, CRC8_INIT or the CRC of the previous part of the data.
+ * @return uint8_t CRC of the data.
+ */
+uint8_t CRC8_Calculate(const uint8_t *data, uint32_t length, uint8_t crcInit);
+
+
+
+#endif /* CRC8_H_ */
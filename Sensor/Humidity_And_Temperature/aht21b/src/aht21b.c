@@ -12,8 +12,18 @@
 /* Includes -------------------------------------------*/
 #include "aht21b.h"
 #include "aht21b_cfg.h"
+#include <crc8.h>
 
 /* Variables ------------------------------------------*/
+/* Measurement in progress */
+static st_Measurement measurement = {AHT21B_STATE_IDLE, STATUS_NOT_OK, 0u, 0u, 0u};
+
+/* Periodic sampling and its sample buffer */
+static st_Sampling sampling;
+static st_SampleBuffer sampleBuffer;
+
+/* I2C transaction counters of the measurements */
+static st_TransactionStatistics transactionStatistics;
 
 
 /* Static Function Declaration ------------------------*/
@@ -25,12 +35,16 @@
 static e_Status AHT21B_ResetRegisters();
 
 /**
- * @brief Reads raw data from the AHT21B sensor.
+ * @brief Reads raw data of the measurement from the AHT21B sensor if it is finished.
+ *
+ * With AHT21B_READ_COMBINED, the status byte and the data come in one plain read and the
+ * status byte is the busy check. With AHT21B_READ_SEPARATE, the status byte is read first and
+ * the data is only read once the sensor is idle.
  *
  * @param[out] rawHumidity Pointer to store raw humidity data.
  * @param[out] rawTemp Pointer to store raw temperature data.
- * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise
- * 					STATS_CRC_ERROR is CRC check is enabled and failed.
+ * @return e_Status STATUS_OK if successful, STATUS_BUSY if the measurement is not finished,
+ * 					STATS_CRC_ERROR is CRC check is enabled and failed, STATUS_NOT_OK otherwise.
  */
 static e_Status AHT21B_ReadRawData(uint32_t *rawHumidity, uint32_t *rawTemp);
 
@@ -42,6 +56,21 @@ static e_Status AHT21B_ReadRawData(uint32_t *rawHumidity, uint32_t *rawTemp);
  */
 static e_Status AHT21B_CheckCRC(uint8_t *crcData);
 
+/**
+ * @brief Converts the raw data of the last measurement to centi-units.
+ *
+ * @param[out] humidityVal Pointer to store the humidity in centi-percent RH.
+ * @param[out] tempVal Pointer to store the temperature in centi-degrees Celsius.
+ */
+static void AHT21B_ConvertRawData(uint16_t *humidityVal, int16_t *tempVal);
+
+/**
+ * @brief Stores a sample in the sample buffer, drops it if the buffer is full.
+ *
+ * @param[in] sample Pointer to the sample.
+ */
+static void AHT21B_StoreSample(const st_Sample *sample);
+
 /* Static Function Definition -------------------------*/
 
 static e_Status AHT21B_ResetRegisters()
@@ -85,90 +114,73 @@ static e_Status AHT21B_ResetRegisters()
 static e_Status AHT21B_ReadRawData(uint32_t *rawHumidity, uint32_t *rawTemp)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t rawDataBuffer[7u] = {0x00};
-	uint8_t startMeasureRequest[AHT21B_MEASUREMENT_SIZE] = {AHT21B_MEASUREMENT_BYTE0, AHT21B_MEASUREMENT_BYTE1};
-	uint8_t count = 0;
+	uint8_t rawDataBuffer[AHT21B_DATA_CRC_LEN] = {0x00};
 	uint32_t localBuffer = 0x00;
 
-	/* Trigger measurement and wait for 80ms as per datahsheet*/
-	returnValue = AHT21B_MemoryWrite(AHT21B_I2C_WRITE_ADDRESS, AHT21B_START_MEASUREMENT, startMeasureRequest, AHT21B_MEASUREMENT_SIZE);
-	COMMON_DELAY(80);
+#if(AHT21B_READ_MODE == AHT21B_READ_COMBINED) /* Can be selected in aht21b_cfg.h */
+	/* Read the status byte, the humidity and temperature data and the CRC in one transfer */
+	returnValue = AHT21B_Receive(AHT21B_I2C_READ_ADDRESS, rawDataBuffer, AHT21B_DATA_CRC_LEN);
+	transactionStatistics.transactionCount++;
+#else
+	/* Read the status byte alone, then the data once idle */
+	returnValue = AHT21B_MemoryRead(AHT21B_I2C_READ_ADDRESS, AHT21B_STATUS_ADDRESS, rawDataBuffer, AHT21B_STATUS_SIZE);
+	transactionStatistics.transactionCount++;
 
-	if(returnValue == STATUS_OK)
+	if( (returnValue == STATUS_OK) && ((rawDataBuffer[0u] & AHT21B_STATUS_BUSY) == 0u) )
 	{
-		/* Wait for Status byte to indicate the completion of measurement */
-		do{
-			(void)AHT21B_MemoryRead(AHT21B_I2C_READ_ADDRESS, AHT21B_STATUS_ADDRESS, rawDataBuffer, AHT21B_STATUS_SIZE);
-			count++;
-			if(count >= AHT21B_MEASUREMENT_TIMEOUT)
-			{
-				break;
-			}
-		}while( (rawDataBuffer[0u] & AHT21B_STATUS_BUSY) == AHT21B_STATUS_BUSY );
-
-		AHT21B_MemoryRead(AHT21B_I2C_READ_ADDRESS, AHT21B_STATUS_ADDRESS, rawDataBuffer, 7u);
-
+		returnValue = AHT21B_MemoryRead(AHT21B_I2C_READ_ADDRESS, AHT21B_STATUS_ADDRESS, rawDataBuffer, AHT21B_DATA_CRC_LEN);
+		transactionStatistics.transactionCount++;
 	}
-	else
+#endif
+
+	if( (returnValue == STATUS_OK) && ((rawDataBuffer[0u] & AHT21B_STATUS_BUSY) == AHT21B_STATUS_BUSY) )
 	{
-		/*Error handler*/
+		/* Measurement not finished, the data is not valid */
+		returnValue = STATUS_BUSY;
 	}
-
-#if(AHT21B_DATA_CRC_CHECK == 1u) /* Can be enabled and disabled in aht21b_cfg.h */
-	if(AHT21B_CheckCRC(rawDataBuffer) == STATUS_OK )
+	else if(returnValue == STATUS_OK)
 	{
+#if(AHT21B_DATA_CRC_CHECK == 1u) /* Can be enabled and disabled in aht21b_cfg.h */
+		if(AHT21B_CheckCRC(rawDataBuffer) == STATUS_OK )
+		{
 #endif
-		/* Store the 20-bits humidity data */
-		localBuffer = (localBuffer | rawDataBuffer[1u] ) << 8u;
-		localBuffer = (localBuffer | rawDataBuffer[2u] ) << 8u;
-		localBuffer = (localBuffer | rawDataBuffer[3u] );
-		localBuffer = localBuffer >> 4u;
-		*rawHumidity = localBuffer;
-
-		/* Store the 20-bits temperature data */
-		localBuffer = 0u;
-		localBuffer = (localBuffer | rawDataBuffer[3u] ) << 8u;
-		localBuffer = (localBuffer | rawDataBuffer[4u] ) << 8u;
-		localBuffer = (localBuffer | rawDataBuffer[5u] );
-		localBuffer = localBuffer & 0xFFFFF;
-		*rawTemp = localBuffer;
+			/* Store the 20-bits humidity data */
+			localBuffer = (localBuffer | rawDataBuffer[1u] ) << 8u;
+			localBuffer = (localBuffer | rawDataBuffer[2u] ) << 8u;
+			localBuffer = (localBuffer | rawDataBuffer[3u] );
+			localBuffer = localBuffer >> 4u;
+			*rawHumidity = localBuffer;
+
+			/* Store the 20-bits temperature data */
+			localBuffer = 0u;
+			localBuffer = (localBuffer | rawDataBuffer[3u] ) << 8u;
+			localBuffer = (localBuffer | rawDataBuffer[4u] ) << 8u;
+			localBuffer = (localBuffer | rawDataBuffer[5u] );
+			localBuffer = localBuffer & 0xFFFFF;
+			*rawTemp = localBuffer;
 
 #if(AHT21B_DATA_CRC_CHECK == 1u)
+		}
+		else
+		{
+			returnValue = STATUS_CRC_ERROR;
+		}
+#endif
 	}
 	else
 	{
-		returnValue = STATUS_CRC_ERROR;
+		/*Error handler*/
 	}
-#endif
 
 	return returnValue;
 }
 
 static e_Status AHT21B_CheckCRC(uint8_t *crcData)
 {
-	uint8_t returnValue = STATUS_NOT_OK;
-	uint8_t dataLoop = 0u;
-	uint8_t bitLoop = 0u;
-	uint8_t crcValue = AHT21B_CRC_INIT;
-
-	for(dataLoop = 0u; dataLoop < AHT21B_DATA_LEN; dataLoop++)
-	{
-		crcValue ^= crcData[dataLoop];
-		for(bitLoop = 0u; bitLoop < AHT21B_DATA_BITS; bitLoop++)
-		{
-			if(crcValue & AHT21B_8TH_BIT_MASK)
-			{
-				crcValue = (crcValue << 1u) ^ AHT21B_CRC_POLY;
-			}
-			else
-			{
-				crcValue = crcValue << 1u;
-			}
-		}
-	}
+	e_Status returnValue = STATUS_NOT_OK;
 
 	/* checking the calculated CRC with the recieved CRC from the sensor */
-	if( crcData[AHT21B_DATA_CRC_POS] == crcValue)
+	if( crcData[AHT21B_DATA_CRC_POS] == CRC8_Calculate(crcData, AHT21B_DATA_LEN, CRC8_INIT) )
 	{
 		returnValue = STATUS_OK;
 	}
@@ -180,6 +192,35 @@ static e_Status AHT21B_CheckCRC(uint8_t *crcData)
 	return returnValue;
 }
 
+static void AHT21B_ConvertRawData(uint16_t *humidityVal, int16_t *tempVal)
+{
+	/* Relative Humidity = raw * 100 / 2^20, scaled by 100 and reduced by 16 to stay in 32 bits */
+	*humidityVal = (uint16_t)( ((measurement.rawHumidity * AHT21B_HUMIDITY_SCALE) + AHT21B_CONVERSION_ROUNDING) >> AHT21B_CONVERSION_SHIFT );
+
+	/* Temperature = (raw * 200 / 2^20) - 50, same scaling */
+	*tempVal = (int16_t)( (int32_t)( ((measurement.rawTemp * AHT21B_TEMPERATURE_SCALE) + AHT21B_CONVERSION_ROUNDING) >> AHT21B_CONVERSION_SHIFT ) - AHT21B_TEMPERATURE_OFFSET );
+}
+
+static void AHT21B_StoreSample(const st_Sample *sample)
+{
+	uint32_t writeIndex = sampleBuffer.writeIndex;
+
+	if( (writeIndex - sampleBuffer.readIndex) < AHT21B_SAMPLE_BUFFER_SIZE )
+	{
+		sampleBuffer.samples[writeIndex & AHT21B_SAMPLE_BUFFER_MASK] = *sample;
+
+		/* The sample must be complete before the consumer can see it */
+		COMMON_MEMORY_BARRIER();
+		sampleBuffer.writeIndex = writeIndex + 1u;
+		sampling.statistics.sampleCount++;
+	}
+	else
+	{
+		/* Buffer full, the producer never moves the read index */
+		sampling.statistics.overrunCount++;
+	}
+}
+
 /* Function Definition --------------------------------*/
 
 e_Status AHT21B_Init()
@@ -215,26 +256,364 @@ e_Status AHT21B_Init()
 e_Status AHT21B_GetTempHumidity(float *humidityVal, float *tempVal)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint32_t rawHumidity = 0;
-	uint32_t rawTemp = 0;
-	float localData = 0.0f;
+	uint16_t humidityFixed = 0u;
+	int16_t tempFixed = 0;
+
+	if( (humidityVal != NULL) && (tempVal != NULL) )
+	{
+		returnValue = AHT21B_GetTempHumidityFixed(&humidityFixed, &tempFixed);
+
+		if(returnValue == STATUS_OK)
+		{
+			*humidityVal = (float)humidityFixed * AHT21B_CENTI_SCALE;
+			*tempVal = (float)tempFixed * AHT21B_CENTI_SCALE;
+		}
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_GetTempHumidityFixed(uint16_t *humidityVal, int16_t *tempVal)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
-	/* Read the raw humidity and temperature */
-	returnValue = AHT21B_ReadRawData(&rawHumidity, &rawTemp);
+	/* Trigger the measurement and wait for the busy bit to clear */
+	returnValue = AHT21B_TriggerMeasurement();
 
-	/* Calculate the Relative humidity and Temperature if the reading is successful */
 	if(returnValue == STATUS_OK)
 	{
-		/* Calculate the Relative Humidity in % */
-		/* Note: 2^20 = 1048576 */
-		localData = ((float)rawHumidity/1048576.0) * 100.0f;
-		*humidityVal = localData;
+		/* The latency follows the conversion of the sensor, AHT21B_Poll() bounds it with its time budget */
+		do{
+			COMMON_DELAY(AHT21B_POLL_DELAY);
+			returnValue = AHT21B_Poll();
+		}while(returnValue == STATUS_BUSY);
+
+		/* Calculate the Relative humidity and Temperature, also releases the measurement on error */
+		returnValue = AHT21B_FetchResultFixed(humidityVal, tempVal);
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_TriggerMeasurement()
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t startMeasureRequest[AHT21B_MEASUREMENT_SIZE] = {AHT21B_MEASUREMENT_BYTE0, AHT21B_MEASUREMENT_BYTE1};
+
+	if( (measurement.state == AHT21B_STATE_BUSY) || (measurement.state == AHT21B_STATE_DONE) )
+	{
+		/* The previous measurement is not fetched yet */
+		returnValue = STATUS_BUSY;
+	}
+	else
+	{
+		returnValue = AHT21B_MemoryWrite(AHT21B_I2C_WRITE_ADDRESS, AHT21B_START_MEASUREMENT, startMeasureRequest, AHT21B_MEASUREMENT_SIZE);
+		transactionStatistics.transactionCount++;
+
+		if(returnValue == STATUS_OK)
+		{
+			measurement.startTick = COMMON_GET_TICK();
+			measurement.result = STATUS_BUSY;
+			measurement.state = AHT21B_STATE_BUSY;
+		}
+		else
+		{
+			/*Error handler*/
+		}
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_Poll()
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	switch(measurement.state)
+	{
+		case AHT21B_STATE_BUSY:
+			/* Reads the data if the busy bit is clear */
+			returnValue = AHT21B_ReadRawData(&measurement.rawHumidity, &measurement.rawTemp);
+
+			if( (returnValue == STATUS_BUSY) && ((uint32_t)(COMMON_GET_TICK() - measurement.startTick) > AHT21B_MEASUREMENT_TIMEOUT) )
+			{
+				returnValue = STATUS_TIMEOUT;
+			}
 
-		/* Calculate the Temperature in Celcius */
-		localData = (((float)rawTemp / 1048576.0) * 200.0f) - 50.0f;
-		*tempVal = localData;
+			if(returnValue == STATUS_OK)
+			{
+				transactionStatistics.measurementCount++;
+			}
+
+			if(returnValue != STATUS_BUSY)
+			{
+				measurement.result = returnValue;
+				measurement.state = (returnValue == STATUS_OK) ? AHT21B_STATE_DONE : AHT21B_STATE_ERROR;
+			}
+			break;
+
+		case AHT21B_STATE_DONE:
+		case AHT21B_STATE_ERROR:
+			returnValue = measurement.result;
+			break;
+
+		default: /* Idle, nothing to advance */
+			returnValue = STATUS_NOT_OK;
+			break;
 	}
 
 	return returnValue;
 }
 
+e_Status AHT21B_FetchResult(float *humidityVal, float *tempVal)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint16_t humidityFixed = 0u;
+	int16_t tempFixed = 0;
+
+	if( (humidityVal != NULL) && (tempVal != NULL) )
+	{
+		returnValue = AHT21B_FetchResultFixed(&humidityFixed, &tempFixed);
+
+		if(returnValue == STATUS_OK)
+		{
+			*humidityVal = (float)humidityFixed * AHT21B_CENTI_SCALE;
+			*tempVal = (float)tempFixed * AHT21B_CENTI_SCALE;
+		}
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_FetchResultFixed(uint16_t *humidityVal, int16_t *tempVal)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	switch(measurement.state)
+	{
+		case AHT21B_STATE_DONE:
+			if( (humidityVal != NULL) && (tempVal != NULL) )
+			{
+				AHT21B_ConvertRawData(humidityVal, tempVal);
+				measurement.state = AHT21B_STATE_IDLE;
+				returnValue = STATUS_OK;
+			}
+			else
+			{
+				/* Handle null pointer, the result stays available */
+				returnValue = STATUS_NOT_OK;
+			}
+			break;
+
+		case AHT21B_STATE_BUSY:
+			returnValue = STATUS_BUSY;
+			break;
+
+		case AHT21B_STATE_ERROR:
+			/* Release the error state so a new measurement can be triggered */
+			measurement.state = AHT21B_STATE_IDLE;
+			returnValue = measurement.result;
+			break;
+
+		default: /* Idle, nothing to fetch */
+			returnValue = STATUS_NOT_OK;
+			break;
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_StartSampling(uint32_t interval)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(interval >= AHT21B_MIN_SAMPLE_INTERVAL)
+	{
+		sampling.enabled = 0u;
+		sampling.interval = interval;
+
+		/* A measurement still in flight belongs to the previous sampling, it is discarded */
+		sampling.measuring = 0u;
+		sampling.statistics.sampleCount = 0u;
+		sampling.statistics.overrunCount = 0u;
+		sampling.statistics.skippedCount = 0u;
+		sampling.statistics.errorCount = 0u;
+
+		/* The consumer skips the samples of the previous sampling, the producer never moves the read index */
+		sampleBuffer.startIndex = sampleBuffer.writeIndex;
+		COMMON_MEMORY_BARRIER();
+
+		/* First slot is due at the next call */
+		sampling.slotTick = COMMON_GET_TICK() - interval;
+		sampling.enabled = 1u;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* A measurement would not fit in the interval */
+	}
+
+	return returnValue;
+}
+
+void AHT21B_StopSampling()
+{
+	uint16_t humidityVal = 0u;
+	int16_t tempVal = 0;
+
+	sampling.enabled = 0u;
+	sampling.measuring = 0u;
+
+	/* A busy measurement stays busy, the sensor is still converting. A finished one is released */
+	if(measurement.state != AHT21B_STATE_BUSY)
+	{
+		(void)AHT21B_FetchResultFixed(&humidityVal, &tempVal);
+	}
+	else
+	{
+		/* Completed by AHT21B_Poll() */
+	}
+}
+
+void AHT21B_ProcessSampling()
+{
+	st_Sample sample = {0u, 0u, 0};
+	e_Status pollStatus = STATUS_NOT_OK;
+	uint32_t currentTick = 0u;
+
+	if(sampling.enabled == 1u)
+	{
+		/* Finish the measurement in progress first, its slot may be the one due now */
+		if(measurement.state != AHT21B_STATE_IDLE)
+		{
+			pollStatus = AHT21B_Poll();
+
+			if( (pollStatus == STATUS_OK) && (sampling.measuring == 1u) )
+			{
+				(void)AHT21B_FetchResultFixed(&sample.humidity, &sample.temperature);
+				sample.timestamp = sampling.sampleTick;
+				AHT21B_StoreSample(&sample);
+				sampling.measuring = 0u;
+			}
+			else if(pollStatus == STATUS_OK)
+			{
+				/* Measurement discarded by AHT21B_StopSampling(), not a sample of this sampling */
+				(void)AHT21B_FetchResultFixed(&sample.humidity, &sample.temperature);
+			}
+			else if(pollStatus != STATUS_BUSY)
+			{
+				/* Releases the error state */
+				(void)AHT21B_FetchResultFixed(&sample.humidity, &sample.temperature);
+				sampling.statistics.errorCount += sampling.measuring;
+				sampling.measuring = 0u;
+			}
+			else
+			{
+				/* Still measuring */
+			}
+		}
+
+		currentTick = COMMON_GET_TICK();
+
+		if( (uint32_t)(currentTick - sampling.slotTick) >= sampling.interval )
+		{
+			/* Keep the slots on the interval grid, count the slots missed by a late call */
+			sampling.slotTick += sampling.interval;
+			while( (uint32_t)(currentTick - sampling.slotTick) >= sampling.interval )
+			{
+				sampling.slotTick += sampling.interval;
+				sampling.statistics.skippedCount++;
+			}
+
+			if( (measurement.state == AHT21B_STATE_IDLE) && (AHT21B_TriggerMeasurement() == STATUS_OK) )
+			{
+				sampling.sampleTick = currentTick;
+				sampling.measuring = 1u;
+			}
+			else if(measurement.state == AHT21B_STATE_BUSY)
+			{
+				sampling.statistics.skippedCount++;
+			}
+			else
+			{
+				/* Trigger failed on the bus */
+				sampling.statistics.errorCount++;
+			}
+		}
+	}
+}
+
+uint32_t AHT21B_ReadSamples(st_Sample *samples, uint32_t maxCount)
+{
+	uint32_t readCount = 0u;
+	uint32_t readIndex = sampleBuffer.readIndex;
+	uint32_t availableCount = sampleBuffer.writeIndex - readIndex;
+	uint32_t staleCount = 0u;
+
+	if(samples != NULL)
+	{
+		/* Read the write index before the start index and the samples */
+		COMMON_MEMORY_BARRIER();
+
+		/* Skip the samples stored before the last start, the start index is behind the read index once they are read */
+		staleCount = sampleBuffer.startIndex - readIndex;
+
+		if(staleCount <= availableCount)
+		{
+			readIndex += staleCount;
+			availableCount -= staleCount;
+		}
+
+		while( (readCount < maxCount) && (readCount < availableCount) )
+		{
+			samples[readCount] = sampleBuffer.samples[(readIndex + readCount) & AHT21B_SAMPLE_BUFFER_MASK];
+			readCount++;
+		}
+
+		/* The samples must be copied before the producer can overwrite them */
+		COMMON_MEMORY_BARRIER();
+		sampleBuffer.readIndex = readIndex + readCount;
+	}
+
+	return readCount;
+}
+
+e_Status AHT21B_GetSamplingStatistics(st_SamplingStatistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(statistics != NULL)
+	{
+		*statistics = sampling.statistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status AHT21B_GetTransactionStatistics(st_TransactionStatistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(statistics != NULL)
+	{
+		*statistics = transactionStatistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+void AHT21B_ResetTransactionStatistics()
+{
+	transactionStatistics.measurementCount = 0u;
+	transactionStatistics.transactionCount = 0u;
+}
@@ -34,19 +34,93 @@
 #define AHT21B_MEASUREMENT_BYTE0			0x33
 #define AHT21B_MEASUREMENT_BYTE1			0x00
 #define AHT21B_MEASUREMENT_SIZE				0x2
-#define AHT21B_MEASUREMENT_TIMEOUT			100u
+#define AHT21B_MEASUREMENT_TIMEOUT			100u	/* Time budget of a measurement (in ms) */
+#define AHT21B_POLL_DELAY					5u		/* Wait before each poll of the blocking read (in ms) */
 
-#define AHT21B_DATA_LEN						6u
-#define AHT21B_DATA_BITS					8u
-#define AHT21B_DATA_CRC_POS					7u
-#define AHT21B_CRC_INIT						0xFF
-#define AHT21B_CRC_POLY						0x31
-#define AHT21B_8TH_BIT_MASK					0x80
+#define AHT21B_DATA_LEN						6u		/* Status byte and the 5 data bytes, covered by the CRC */
+#define AHT21B_DATA_CRC_POS					6u		/* CRC byte follows the data */
+#define AHT21B_DATA_CRC_LEN					(AHT21B_DATA_LEN + 1u)
+
+/* Conversion of the 20-bits raw data to centi-units: value = (raw * scale) >> 16, scale = 100 * range / 16 */
+#define AHT21B_CONVERSION_SHIFT				16u
+#define AHT21B_CONVERSION_ROUNDING			(1uL << (AHT21B_CONVERSION_SHIFT - 1u))
+#define AHT21B_HUMIDITY_SCALE				625u	/* 100 %RH range */
+#define AHT21B_TEMPERATURE_SCALE			1250u	/* 200 Celsius range */
+#define AHT21B_TEMPERATURE_OFFSET			5000	/* -50 Celsius, in centi-degrees */
+#define AHT21B_CENTI_SCALE					0.01f
+
+/* Periodic sampling, the buffer size must be a power of 2 */
+#define AHT21B_SAMPLE_BUFFER_SIZE			16u
+#define AHT21B_SAMPLE_BUFFER_MASK			(AHT21B_SAMPLE_BUFFER_SIZE - 1u)
+#define AHT21B_MIN_SAMPLE_INTERVAL			AHT21B_MEASUREMENT_TIMEOUT	/* in ms, a measurement must fit in the interval */
 
 
 /* Enums ----------------------------------------------*/
+typedef enum e_MeasurementState
+{
+	AHT21B_STATE_IDLE = 0x00,
+	AHT21B_STATE_BUSY,				/* Measurement in progress */
+	AHT21B_STATE_DONE,				/* Result ready to be fetched */
+	AHT21B_STATE_ERROR
+}e_MeasurementState;
 
 /* Structures -----------------------------------------*/
+typedef struct st_Measurement
+{
+	e_MeasurementState state;
+	e_Status  result;				/* Status of the last measurement, reported by AHT21B_FetchResult() */
+	uint32_t  startTick;
+	uint32_t  rawHumidity;
+	uint32_t  rawTemp;
+}st_Measurement;
+
+/* Timestamped sample of the periodic sampling */
+typedef struct st_Sample
+{
+	uint32_t  timestamp;			/* COMMON_GET_TICK() at the trigger of the measurement */
+	uint16_t  humidity;				/* centi-percent RH */
+	int16_t   temperature;			/* centi-degrees Celsius */
+}st_Sample;
+
+/*
+ * Single-producer/single-consumer ring buffer. The write and start indexes are only written by the
+ * producer (AHT21B_StartSampling() and AHT21B_ProcessSampling()) and the read index only by
+ * AHT21B_ReadSamples(), so no lock is needed. The indexes run freely, the number of stored samples
+ * is writeIndex - readIndex. The samples before startIndex are from a previous sampling, the
+ * consumer skips them.
+ */
+typedef struct st_SampleBuffer
+{
+	st_Sample samples[AHT21B_SAMPLE_BUFFER_SIZE];
+	volatile uint32_t writeIndex;
+	volatile uint32_t startIndex;	/* Write index at the last AHT21B_StartSampling() */
+	volatile uint32_t readIndex;
+}st_SampleBuffer;
+
+typedef struct st_SamplingStatistics
+{
+	uint32_t  sampleCount;			/* Samples stored in the buffer */
+	uint32_t  overrunCount;			/* Samples dropped because the buffer was full */
+	uint32_t  skippedCount;			/* Trigger slots missed because the previous measurement was not done */
+	uint32_t  errorCount;			/* Measurements failed (bus error, timeout or CRC error) */
+}st_SamplingStatistics;
+
+/* I2C transactions of the measurements, transactionCount / measurementCount is the cost of a sample */
+typedef struct st_TransactionStatistics
+{
+	uint32_t  measurementCount;		/* Measurements completed */
+	uint32_t  transactionCount;		/* I2C transactions of the measurements (trigger, status and data reads) */
+}st_TransactionStatistics;
+
+typedef struct st_Sampling
+{
+	uint8_t   enabled;
+	uint8_t   measuring;			/* The measurement in progress was triggered by this sampling */
+	uint32_t  interval;				/* in ms */
+	uint32_t  slotTick;				/* Tick of the last trigger slot */
+	uint32_t  sampleTick;			/* Tick of the measurement in progress */
+	st_SamplingStatistics statistics;
+}st_Sampling;
 
 /* Variables ------------------------------------------*/
 
@@ -68,6 +142,132 @@ e_Status AHT21B_Init();
  */
 e_Status AHT21B_GetTempHumidity(float *humidityVal, float *tempVal);
 
+/**
+ * @brief Reads the temperature and humidity values from the AHT21B sensor in fixed point.
+ *
+ * Blocking: polls every AHT21B_POLL_DELAY ms from the trigger, so it returns as soon as the sensor
+ * finishes the conversion, within AHT21B_MEASUREMENT_TIMEOUT ms. The conversion uses integer
+ * multiplies and shifts only.
+ *
+ * @param[out] humidityVal Pointer to store the humidity in centi-percent RH (0 to 10000).
+ * @param[out] tempVal Pointer to store the temperature in centi-degrees Celsius (-5000 to 15000).
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status AHT21B_GetTempHumidityFixed(uint16_t *humidityVal, int16_t *tempVal);
+
+/**
+ * @brief Triggers a measurement on the AHT21B sensor without waiting for it.
+ *
+ * The function returns right after the trigger command is written. Use AHT21B_Poll()
+ * to advance the measurement and AHT21B_FetchResult() to collect it.
+ *
+ * @return e_Status STATUS_OK if triggered, STATUS_BUSY if a measurement is already in progress,
+ * 					STATUS_NOT_OK otherwise.
+ */
+e_Status AHT21B_TriggerMeasurement();
+
+/**
+ * @brief Advances the measurement started by AHT21B_TriggerMeasurement().
+ *
+ * Must be called periodically. It never waits for the sensor, the measurement completes as soon
+ * as the busy bit clears. Each call is one I2C read in AHT21B_READ_COMBINED mode (the default):
+ * the status byte, the data and the CRC (7 bytes). In AHT21B_READ_SEPARATE mode it reads the status
+ * byte alone, then the 7 bytes once the busy bit is clear. The measurement fails if the busy bit
+ * is still set after AHT21B_MEASUREMENT_TIMEOUT ms, checked with COMMON_GET_TICK().
+ *
+ * @return e_Status STATUS_BUSY while measuring, STATUS_OK once the result is ready,
+ * 					STATUS_TIMEOUT if the time budget is exceeded, STATUS_CRC_ERROR if the CRC
+ * 					check is enabled and failed, STATUS_NOT_OK otherwise.
+ */
+e_Status AHT21B_Poll();
+
+/**
+ * @brief Collects the result of a finished measurement.
+ *
+ * Releases the measurement so a new one can be triggered.
+ *
+ * @param[out] humidityVal Pointer to store the calculated humidity value.
+ * @param[out] tempVal Pointer to store the calculated temperature value.
+ * @return e_Status STATUS_OK if a result was available, STATUS_BUSY if still measuring,
+ * 					the error of the measurement otherwise.
+ */
+e_Status AHT21B_FetchResult(float *humidityVal, float *tempVal);
+
+/**
+ * @brief Collects the result of a finished measurement in fixed point.
+ *
+ * Releases the measurement so a new one can be triggered.
+ *
+ * @param[out] humidityVal Pointer to store the humidity in centi-percent RH.
+ * @param[out] tempVal Pointer to store the temperature in centi-degrees Celsius.
+ * @return e_Status STATUS_OK if a result was available, STATUS_BUSY if still measuring,
+ * 					the error of the measurement otherwise.
+ */
+e_Status AHT21B_FetchResultFixed(uint16_t *humidityVal, int16_t *tempVal);
+
+/**
+ * @brief Starts the periodic sampling of the AHT21B sensor.
+ *
+ * The first measurement is triggered by the next AHT21B_ProcessSampling() call, then one every
+ * interval. Clears the statistics, the samples of a previous sampling are skipped by the next
+ * AHT21B_ReadSamples() (they hold their place in the buffer until then). The application must not
+ * trigger measurements itself while the periodic sampling runs.
+ *
+ * @param[in] interval Sampling interval in ms, at least AHT21B_MIN_SAMPLE_INTERVAL.
+ * @return e_Status STATUS_OK if started, STATUS_NOT_OK if the interval is too short.
+ */
+e_Status AHT21B_StartSampling(uint32_t interval);
+
+/**
+ * @brief Stops the periodic sampling. A measurement in progress is discarded.
+ *
+ * The sensor is still converting, so the measurement stays busy until AHT21B_Poll() (or the next
+ * AHT21B_ProcessSampling() of a new sampling) completes it, then AHT21B_FetchResult() releases it.
+ * The samples already stored in the buffer can still be read.
+ */
+void AHT21B_StopSampling();
+
+/**
+ * @brief Runs the periodic sampling, producer side of the sample buffer.
+ *
+ * Must be called periodically from the main loop or a task, not from an interrupt: the I2C
+ * transfers are blocking HAL calls. It never waits for the sensor: it triggers the measurement
+ * when the interval has elapsed, advances the measurement in progress and stores the finished sample.
+ */
+void AHT21B_ProcessSampling();
+
+/**
+ * @brief Reads the stored samples, consumer side of the sample buffer.
+ *
+ * Can be called from another context than AHT21B_ProcessSampling().
+ *
+ * @param[out] samples Pointer to store the samples, oldest first.
+ * @param[in] maxCount Maximum number of samples to read.
+ * @return uint32_t Number of samples read.
+ */
+uint32_t AHT21B_ReadSamples(st_Sample *samples, uint32_t maxCount);
+
+/**
+ * @brief Gets the statistics of the periodic sampling.
+ *
+ * @param[out] statistics Pointer to store the statistics.
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status AHT21B_GetSamplingStatistics(st_SamplingStatistics *statistics);
+
+/**
+ * @brief Gets the I2C transaction counters of the measurements.
+ *
+ * @param[out] statistics Pointer to store the counters.
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status AHT21B_GetTransactionStatistics(st_TransactionStatistics *statistics);
+
+/**
+ * @brief Clears the I2C transaction counters of the measurements.
+ */
+void AHT21B_ResetTransactionStatistics();
+
 
 
 #endif /* AHT21B_H_ */
@@ -19,9 +19,13 @@
 #define AHT21B_TRIAL				3u
 #define AHT21B_MEMORY_REG_SIZE		I2C_MEMADD_SIZE_8BIT		/* If the memory register size is 8 bits(0x01) or 16 bits */
 
-/* Enable this for having CRC check on each sensor data. This will increase the latency of system */
-/* AHT21B is not sending proper CRC data. */
-#define AHT21B_DATA_CRC_CHECK		0u
+/* Enable this for having CRC check on each sensor data. The CRC is table driven (see crc8.h), the cost is one lookup per byte */
+#define AHT21B_DATA_CRC_CHECK		1u
+
+/* Read of the measurement result */
+#define AHT21B_READ_SEPARATE		0x00	/* 1 byte status reads until idle, then a separate data read */
+#define AHT21B_READ_COMBINED		0x01	/* Status and data in one plain read, repeated while busy */
+#define AHT21B_READ_MODE			AHT21B_READ_COMBINED
 
 /* Function Definition --------------------------------*/
 /*
@@ -60,5 +64,18 @@ e_Status AHT21B_MemoryRead(uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *rea
     return HAL_I2C_Mem_Read(AHT21B_I2C_HANDLER, deviceAddr, memoryAddr, AHT21B_MEMORY_REG_SIZE, readDataBuffer, (uint16_t)readDataSize, AHT21B_TIMEOUT);
 }
 
+/*
+ * @brief  Reads data from the AHT21B sensor without register address (plain read).
+ * @note   The AHT21B streams the status byte followed by the measurement data.
+ * @param  deviceAddr       Address of the AHT21B device.
+ * @param  readDataBuffer   Pointer to the data buffer to store the read data.
+ * @param  readDataSize     Size of the data to be read.
+ * @retval e_Status  Status of the read operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status AHT21B_Receive(uint8_t deviceAddr, uint8_t *readDataBuffer, uint8_t readDataSize)
+{
+    return HAL_I2C_Master_Receive(AHT21B_I2C_HANDLER, deviceAddr, readDataBuffer, (uint16_t)readDataSize, AHT21B_TIMEOUT);
+}
+
 
 #endif /* AHT21B_CFG_H_ */
@@ -0,0 +1,578 @@
+/**
+ * @file aht21b_sim.c
+ * @brief Host simulator of the AHT21B driver on a model of the sensor
+ *
+ * The model has the status byte with the busy bit, the trigger command, the plain read of the
+ * status, the 5 data bytes and the CRC, and a conversion time set by the checks. The bus runs at
+ * 400 kHz. The checks measure the latency of the blocking and of the non-blocking measurement over
+ * conversion times around the 80 ms of the data sheet, the timeout and the CRC error, and compare
+ * the conversion to centi-units with the formulas of the data sheet. The periodic sampling runs
+ * with a consumer at random times, stalls of the main loop, restarts and stops. The consumer also
+ * runs at the memory barriers of the producer and the producer (or a restart) at the barriers of
+ * the consumer. Each measurement carries its trigger number, the samples read are checked against
+ * the trigger order, the sampling they belong to and the slots of the interval.
+ *
+ * Build and run from the root of the repository:
+ *   gcc -std=c99 -Wall -I Misc -I Sensor/Humidity_And_Temperature/aht21b/test/stub
+ *       -I Sensor/Humidity_And_Temperature/aht21b/src
+ *       Sensor/Humidity_And_Temperature/aht21b/test/aht21b_sim.c
+ *       Sensor/Humidity_And_Temperature/aht21b/src/aht21b.c Misc/crc8.c -lm -o aht21b_sim && ./aht21b_sim
+ *
+ * The exit code is 0 when all the checks pass.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <aht21b.h>
+#include <crc8.h>
+
+/* Macro Definition -----------------------------------*/
+#define SIM_BYTE_TIME_US			22.5		/* 400 kHz, 9 bits per byte with the acknowledge */
+#define SIM_LOOP_WORK_US			1000.0		/* Work of the main loop between two polls */
+#define SIM_MEASUREMENT_COUNT		20u			/* Measurements per conversion time */
+#define SIM_CONVERSION_COUNT		100000L		/* Random raw values of the conversion check */
+#define SIM_SAMPLING_TIME_US		500e6		/* Duration of the sampling check */
+#define SIM_TRIGGER_MAX				10000u		/* Trigger numbers of the sampling check, below 100.00 %RH */
+#define SIM_READ_MAX				8u			/* Samples per read of the consumer */
+
+/* Side of the sample buffer running when a barrier is reached */
+#define SIM_ROLE_NONE				0u
+#define SIM_ROLE_PRODUCER			1u
+#define SIM_ROLE_CONSUMER			2u
+
+/* Structures -----------------------------------------*/
+
+/* Status, conversion and output of the AHT21B */
+typedef struct
+{
+	uint8_t   status;
+	uint32_t  rawHumidity;			/* 20 bits, loaded in the output at the end of the conversion */
+	uint32_t  rawTemp;
+	uint8_t   out[AHT21B_DATA_CRC_LEN];
+	double    conversionTime;		/* in us */
+	double    conversionEnd;
+	uint8_t   converting;
+	uint8_t   failCrc;				/* The CRC of the next result is wrong */
+	uint8_t   numbered;				/* The result is the trigger number: humidity n, temperature n - 5000 */
+	uint32_t  triggerCount;
+	uint32_t  triggerTick[SIM_TRIGGER_MAX];
+}st_SimSensor;
+
+/* Consumer of the periodic sampling and the checks of the samples read */
+typedef struct
+{
+	uint32_t  generation;			/* Incremented by each AHT21B_StartSampling() */
+	uint32_t  firstTrigger;			/* First trigger number of the sampling */
+	uint32_t  startTick;
+	uint32_t  interval;
+	uint32_t  lastTrigger;
+	long      lastSlot;
+	uint32_t  readCount;			/* Samples of the sampling read */
+	uint32_t  lateCount;			/* Samples of the previous sampling, read across a restart */
+	uint32_t  staleCount;			/* Samples of a previous sampling read after the restart */
+	uint32_t  orderCount;			/* Samples repeated or out of the trigger order */
+	uint32_t  tornCount;			/* Humidity and temperature of different measurements */
+	uint32_t  timeCount;			/* Timestamps not at the trigger or two in one slot */
+}st_SimConsumer;
+
+/* Totals of the sampling statistics over the samplings */
+typedef struct
+{
+	uint32_t  samplingCount;
+	uint32_t  discardCount;			/* Measurements in flight at a restart */
+	uint32_t  accountCount;			/* Samplings whose triggers are not all accounted */
+	uint32_t  interleaveCount;		/* Barriers where the other side ran */
+	st_SamplingStatistics statistics;
+}st_SimTotals;
+
+/* Variables ------------------------------------------*/
+I2C_HandleTypeDef hi2c1;
+
+static double simTime = 0.0;				/* in us */
+static st_SimSensor sensor;
+static st_SimConsumer consumer;
+static st_SimTotals totals;
+static uint8_t role = SIM_ROLE_NONE;
+static uint8_t interleave = 0u;				/* The barriers run the other side */
+static uint8_t nested = 0u;					/* The other side is running, its barriers do nothing */
+static double slowUntil = 0.0;				/* The consumer does not read until then */
+
+static const double conversionTime[] = {20000.0, 40000.0, 80000.0, 95000.0};
+
+/* Static Function Declaration ------------------------*/
+static void SIM_Bus(uint32_t byteCount);
+static void SIM_Sensor(void);
+static int SIM_Latency(void);
+static int SIM_Conversion(void);
+static uint32_t SIM_Consume(uint32_t maxCount);
+static void SIM_Produce(void);
+static void SIM_Account(uint8_t drained);
+static void SIM_Restart(uint32_t interval);
+static int SIM_Sampling(void);
+
+/* HAL model ------------------------------------------*/
+
+void HAL_Delay(uint32_t Delay)
+{
+	simTime += Delay * 1000.0;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	/* Spinning on the tick costs time */
+	simTime += 1.0;
+
+	return (uint32_t)(simTime / 1000.0);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+	(void)hi2c; (void)Trials; (void)Timeout;
+	SIM_Bus(1u);
+
+	return (DevAddress == AHT21B_I2C_WRITE_ADDRESS) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+
+	(void)hi2c; (void)MemAddSize; (void)Timeout;
+	SIM_Bus(2u + Size);
+
+	if( (DevAddress == AHT21B_I2C_WRITE_ADDRESS) && (MemAddress == AHT21B_START_MEASUREMENT) && (Size == AHT21B_MEASUREMENT_SIZE)
+		&& (pData[0] == AHT21B_MEASUREMENT_BYTE0) && (pData[1] == AHT21B_MEASUREMENT_BYTE1) )
+	{
+		/* The conversion starts at the stop condition, a trigger during a conversion starts it again */
+		sensor.status |= AHT21B_STATUS_BUSY;
+		sensor.conversionEnd = simTime + sensor.conversionTime;
+		sensor.converting = 1u;
+		sensor.triggerCount++;
+		if( (sensor.numbered == 1u) && (sensor.triggerCount < SIM_TRIGGER_MAX) )
+		{
+			sensor.triggerTick[sensor.triggerCount] = (uint32_t)(simTime / 1000.0);
+			sensor.rawHumidity = (uint32_t)((sensor.triggerCount * 1048576.0 / 10000.0) + 0.5);
+			sensor.rawTemp = (uint32_t)((sensor.triggerCount * 1048576.0 / 20000.0) + 0.5);
+		}
+		returnValue = HAL_OK;
+	}
+	else if(DevAddress == AHT21B_I2C_WRITE_ADDRESS)
+	{
+		/* Calibration registers, accepted */
+		returnValue = HAL_OK;
+	}
+	else
+	{
+		/* Not acknowledged */
+	}
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+
+	(void)hi2c; (void)MemAddSize; (void)Timeout;
+	SIM_Bus(3u + Size);
+	SIM_Sensor();
+
+	if( (DevAddress == AHT21B_I2C_READ_ADDRESS) && (MemAddress == AHT21B_STATUS_ADDRESS) && (Size <= AHT21B_DATA_CRC_LEN) )
+	{
+		/* The register address is ignored, the sensor streams the status and the output */
+		sensor.out[0] = sensor.status;
+		memcpy(pData, sensor.out, Size);
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+
+	(void)hi2c; (void)Timeout;
+	SIM_Bus(1u + Size);
+	SIM_Sensor();
+
+	if( (DevAddress == AHT21B_I2C_READ_ADDRESS) && (Size <= AHT21B_DATA_CRC_LEN) )
+	{
+		sensor.out[0] = sensor.status;
+		memcpy(pData, sensor.out, Size);
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+void SIM_Barrier(void)
+{
+	uint8_t barrierRole = role;
+
+	/* The other side runs between the accesses ordered by the barrier */
+	if( (interleave == 1u) && (nested == 0u) && (barrierRole != SIM_ROLE_NONE) && ((rand() % 4) == 0) )
+	{
+		totals.interleaveCount++;
+		nested = 1u;
+		if( (barrierRole == SIM_ROLE_PRODUCER) && (simTime >= slowUntil) )
+		{
+			(void)SIM_Consume(1u + ((uint32_t)rand() % SIM_READ_MAX));
+		}
+		else if(barrierRole == SIM_ROLE_PRODUCER)
+		{
+			/* The consumer is not reading */
+		}
+		else if((rand() % 50) == 0)
+		{
+			SIM_Restart(AHT21B_MIN_SAMPLE_INTERVAL + ((uint32_t)rand() % 200u));
+		}
+		else
+		{
+			/* The producer runs long enough to store a sample in a slot the consumer released */
+			for(uint32_t loop = (uint32_t)rand() % 300u; loop > 0u; loop--)
+			{
+				simTime += 1000.0;
+				SIM_Produce();
+			}
+		}
+		nested = 0u;
+		role = barrierRole;
+	}
+}
+
+/* Static Function Definition -------------------------*/
+
+static void SIM_Bus(uint32_t byteCount)
+{
+	simTime += byteCount * SIM_BYTE_TIME_US;
+}
+
+static void SIM_Sensor(void)
+{
+	/* End of conversion: output loaded with its CRC, busy bit cleared */
+	if( (sensor.converting == 1u) && (simTime >= sensor.conversionEnd) )
+	{
+		sensor.converting = 0u;
+		sensor.status &= (uint8_t)~AHT21B_STATUS_BUSY;
+		sensor.out[0] = sensor.status;
+		sensor.out[1] = (uint8_t)(sensor.rawHumidity >> 12u);
+		sensor.out[2] = (uint8_t)(sensor.rawHumidity >> 4u);
+		sensor.out[3] = (uint8_t)((sensor.rawHumidity << 4u) | (sensor.rawTemp >> 16u));
+		sensor.out[4] = (uint8_t)(sensor.rawTemp >> 8u);
+		sensor.out[5] = (uint8_t)sensor.rawTemp;
+		sensor.out[AHT21B_DATA_CRC_POS] = CRC8_Calculate(sensor.out, AHT21B_DATA_LEN, CRC8_INIT) ^ sensor.failCrc;
+		sensor.failCrc = 0u;
+	}
+}
+
+static int SIM_Latency(void)
+{
+	int failCount = 0;
+	e_Status status = STATUS_OK;
+	st_TransactionStatistics transactions;
+	uint16_t humidity = 0u;
+	int16_t temperature = 0;
+	double startTime = 0.0;
+	double latency = 0.0;
+	double maxLatency = 0.0;
+	double callStart = 0.0;
+	double callTime = 0.0;
+	double maxCallTime = 0.0;
+
+	printf("Latency: blocking read, then trigger and poll every %.1f ms\n", SIM_LOOP_WORK_US / 1000.0);
+	memset(&sensor, 0, sizeof(sensor));
+	sensor.status = AHT21B_STATUS_CONST;
+	sensor.rawHumidity = 0x80000u;		/* 50.00 %RH */
+	sensor.rawTemp = 0x66666u;			/* 30.00 C */
+	failCount += (AHT21B_Init() != STATUS_OK);
+
+	for(uint8_t index = 0u; index < (sizeof(conversionTime) / sizeof(conversionTime[0])); index++)
+	{
+		sensor.conversionTime = conversionTime[index];
+
+		/* Blocking read: the conversion and at most one poll delay */
+		AHT21B_ResetTransactionStatistics();
+		maxLatency = 0.0;
+		for(uint8_t sample = 0u; sample < SIM_MEASUREMENT_COUNT; sample++)
+		{
+			startTime = simTime;
+			status = AHT21B_GetTempHumidityFixed(&humidity, &temperature);
+			latency = simTime - startTime;
+			maxLatency = (latency > maxLatency) ? latency : maxLatency;
+			failCount += (status != STATUS_OK) + (humidity != 5000u) + (temperature != 3000);
+		}
+		failCount += (maxLatency > (sensor.conversionTime + (AHT21B_POLL_DELAY * 1000.0) + 500.0));
+		AHT21B_GetTransactionStatistics(&transactions);
+		printf("  %4.0f ms conversion: blocking %5.1f ms, %.1f transactions,", sensor.conversionTime / 1000.0, maxLatency / 1000.0,
+				(double)transactions.transactionCount / transactions.measurementCount);
+
+		/* Non-blocking: the conversion and at most one loop period, each call a single transfer */
+		maxLatency = 0.0;
+		maxCallTime = 0.0;
+		for(uint8_t sample = 0u; sample < SIM_MEASUREMENT_COUNT; sample++)
+		{
+			startTime = simTime;
+			failCount += (AHT21B_TriggerMeasurement() != STATUS_OK);
+			failCount += (AHT21B_TriggerMeasurement() != STATUS_BUSY);
+			do
+			{
+				simTime += SIM_LOOP_WORK_US;
+				callStart = simTime;
+				status = AHT21B_Poll();
+				callTime = simTime - callStart;
+				maxCallTime = (callTime > maxCallTime) ? callTime : maxCallTime;
+			}while(status == STATUS_BUSY);
+
+			latency = simTime - startTime;
+			maxLatency = (latency > maxLatency) ? latency : maxLatency;
+			failCount += (status != STATUS_OK);
+			failCount += (AHT21B_FetchResultFixed(&humidity, &temperature) != STATUS_OK) + (humidity != 5000u) + (temperature != 3000);
+			failCount += (AHT21B_FetchResultFixed(&humidity, &temperature) != STATUS_NOT_OK);
+		}
+		failCount += (maxLatency > (sensor.conversionTime + SIM_LOOP_WORK_US + 500.0)) + (maxCallTime > 500.0);
+		printf(" non-blocking %5.1f ms, longest call %.0f us\n", maxLatency / 1000.0, maxCallTime);
+	}
+
+	/* A conversion longer than the time budget ends with a timeout, the next one succeeds */
+	sensor.conversionTime = 150000.0;
+	startTime = simTime;
+	status = AHT21B_GetTempHumidityFixed(&humidity, &temperature);
+	latency = simTime - startTime;
+	failCount += (status != STATUS_TIMEOUT) + (latency > ((AHT21B_MEASUREMENT_TIMEOUT + 2u * AHT21B_POLL_DELAY) * 1000.0));
+	printf("  150 ms conversion: timeout after %.1f ms,", latency / 1000.0);
+
+	sensor.conversionTime = 80000.0;
+	failCount += (AHT21B_GetTempHumidityFixed(&humidity, &temperature) != STATUS_OK) + (humidity != 5000u);
+
+	/* A wrong CRC fails the measurement, the next one succeeds */
+	sensor.failCrc = 0x01u;
+	failCount += (AHT21B_GetTempHumidityFixed(&humidity, &temperature) != STATUS_CRC_ERROR);
+	failCount += (AHT21B_GetTempHumidityFixed(&humidity, &temperature) != STATUS_OK) + (temperature != 3000);
+	printf(" CRC error and recovery: %s\n", (failCount == 0) ? "yes" : "no");
+
+	return failCount;
+}
+
+static int SIM_Conversion(void)
+{
+	int failCount = 0;
+	uint16_t humidity = 0u;
+	int16_t temperature = 0;
+	uint32_t badCount = 0u;
+
+	printf("Conversion: %ld random raw values against the data sheet formulas\n", SIM_CONVERSION_COUNT);
+	sensor.conversionTime = 0.0;
+
+	for(long sample = 0L; sample < (SIM_CONVERSION_COUNT + 2L); sample++)
+	{
+		/* The ends of the range first */
+		sensor.rawHumidity = (sample < 2L) ? (uint32_t)(sample * 0xFFFFFL) : ((uint32_t)rand() & 0xFFFFFu);
+		sensor.rawTemp = (sample < 2L) ? (uint32_t)(sample * 0xFFFFFL) : ((uint32_t)rand() & 0xFFFFFu);
+		failCount += (AHT21B_TriggerMeasurement() != STATUS_OK);
+		failCount += (AHT21B_Poll() != STATUS_OK);
+		failCount += (AHT21B_FetchResultFixed(&humidity, &temperature) != STATUS_OK);
+
+		/* RH = raw / 2^20 * 100 %, T = raw / 2^20 * 200 - 50 C, rounded to centi-units */
+		badCount += (humidity != (uint16_t)floor((sensor.rawHumidity * 10000.0 / 1048576.0) + 0.5));
+		badCount += (temperature != (int16_t)(floor((sensor.rawTemp * 20000.0 / 1048576.0) + 0.5) - 5000.0));
+	}
+
+	printf("  %u values different from the formulas\n", badCount);
+	failCount += (int)badCount;
+
+	return failCount;
+}
+
+static uint32_t SIM_Consume(uint32_t maxCount)
+{
+	st_Sample samples[SIM_READ_MAX];
+	uint32_t readCount = 0u;
+	uint32_t generation = consumer.generation;
+	uint32_t trigger = 0u;
+	long slot = 0L;
+	uint8_t previousRole = role;
+
+	role = SIM_ROLE_CONSUMER;
+	readCount = AHT21B_ReadSamples(samples, maxCount);
+	role = previousRole;
+
+	for(uint32_t index = 0u; index < readCount; index++)
+	{
+		trigger = samples[index].humidity;
+		consumer.tornCount += ((int32_t)samples[index].humidity - samples[index].temperature != 5000);
+
+		if( (trigger < consumer.firstTrigger) && (generation != consumer.generation) )
+		{
+			/* Read before the restart completed */
+			consumer.lateCount++;
+		}
+		else if(trigger < consumer.firstTrigger)
+		{
+			consumer.staleCount++;
+		}
+		else
+		{
+			consumer.orderCount += (trigger <= consumer.lastTrigger);
+			consumer.lastTrigger = trigger;
+			consumer.readCount++;
+
+			/* Tick of the trigger, one slot of the interval grid per sample */
+			slot = ((long)samples[index].timestamp - (long)consumer.startTick) / (long)consumer.interval;
+			consumer.timeCount += (samples[index].timestamp > sensor.triggerTick[trigger]) || ((samples[index].timestamp + 1u) < sensor.triggerTick[trigger]);
+			consumer.timeCount += (samples[index].timestamp < consumer.startTick) || (slot <= consumer.lastSlot);
+			consumer.lastSlot = slot;
+		}
+	}
+
+	return readCount;
+}
+
+static void SIM_Produce(void)
+{
+	uint8_t previousRole = role;
+
+	role = SIM_ROLE_PRODUCER;
+	AHT21B_ProcessSampling();
+	role = previousRole;
+}
+
+static void SIM_Account(uint8_t drained)
+{
+	st_SamplingStatistics statistics;
+	uint32_t triggerCount = sensor.triggerCount + 1u - consumer.firstTrigger;
+	uint32_t accounted = 0u;
+
+	/* Each trigger of the sampling is a sample, an overrun or an error, or still in flight */
+	AHT21B_GetSamplingStatistics(&statistics);
+	accounted = statistics.sampleCount + statistics.overrunCount + statistics.errorCount;
+	totals.accountCount += ( (triggerCount != accounted) && (triggerCount != (accounted + 1u)) );
+	totals.accountCount += (consumer.readCount > statistics.sampleCount) || ((drained == 1u) && (consumer.readCount != statistics.sampleCount));
+	totals.discardCount += (triggerCount == (accounted + 1u));
+	totals.statistics.sampleCount += statistics.sampleCount;
+	totals.statistics.overrunCount += statistics.overrunCount;
+	totals.statistics.skippedCount += statistics.skippedCount;
+	totals.statistics.errorCount += statistics.errorCount;
+}
+
+static void SIM_Restart(uint32_t interval)
+{
+	uint8_t previousRole = role;
+
+	if(consumer.generation != 0u)
+	{
+		SIM_Account(0u);
+	}
+
+	/* The first slot is at the tick read by AHT21B_StartSampling() */
+	consumer.generation++;
+	consumer.firstTrigger = sensor.triggerCount + 1u;
+	consumer.startTick = (uint32_t)((simTime + 1.0) / 1000.0);
+	consumer.interval = interval;
+	consumer.lastTrigger = consumer.firstTrigger - 1u;
+	consumer.lastSlot = -1L;
+	consumer.readCount = 0u;
+	totals.samplingCount++;
+
+	role = SIM_ROLE_PRODUCER;
+	if(AHT21B_StartSampling(interval) != STATUS_OK)
+	{
+		totals.accountCount++;
+	}
+	role = previousRole;
+}
+
+static int SIM_Sampling(void)
+{
+	int failCount = 0;
+	uint32_t gap = 0u;
+
+	printf("Sampling: random consumer, stalls, restarts and stops over %.0f s\n", SIM_SAMPLING_TIME_US / 1e6);
+	memset(&sensor, 0, sizeof(sensor));
+	memset(&consumer, 0, sizeof(consumer));
+	memset(&totals, 0, sizeof(totals));
+	sensor.status = AHT21B_STATUS_CONST;
+	sensor.conversionTime = 80000.0;
+	sensor.numbered = 1u;
+	simTime = 0.0;
+	slowUntil = 0.0;
+	failCount += (AHT21B_StartSampling(AHT21B_MIN_SAMPLE_INTERVAL - 1u) != STATUS_NOT_OK);
+	interleave = 1u;
+	SIM_Restart(AHT21B_MIN_SAMPLE_INTERVAL);
+
+	while(simTime < SIM_SAMPLING_TIME_US)
+	{
+		/* Main loop period, with a stall now and then */
+		gap = ((rand() % 1000) < 3) ? (150u + ((uint32_t)rand() % 300u)) : (1u + ((uint32_t)rand() % 5u));
+		simTime += gap * 1000.0;
+		sensor.failCrc = ((rand() % 2000) == 0) ? 0x01u : sensor.failCrc;
+		SIM_Produce();
+
+		/* The consumer reads a few samples now and then, and stops reading for a while */
+		slowUntil = ((rand() % 5000) == 0) ? (simTime + 5e6) : slowUntil;
+		if( (simTime >= slowUntil) && ((rand() % 10) == 0) )
+		{
+			(void)SIM_Consume(1u + ((uint32_t)rand() % SIM_READ_MAX));
+		}
+
+		if((rand() % 3000) == 0)
+		{
+			SIM_Restart(AHT21B_MIN_SAMPLE_INTERVAL + ((uint32_t)rand() % 200u));
+		}
+		else if((rand() % 5000) == 0)
+		{
+			/* Stop, read the remaining samples, start again later */
+			AHT21B_StopSampling();
+			interleave = 0u;
+			while(SIM_Consume(SIM_READ_MAX) > 0u) {}
+			SIM_Account(1u);
+			consumer.generation = 0u;
+			interleave = 1u;
+			simTime += (rand() % 200) * 1000.0;
+			SIM_Restart(AHT21B_MIN_SAMPLE_INTERVAL + ((uint32_t)rand() % 200u));
+		}
+		else
+		{
+			/* Keep sampling */
+		}
+	}
+
+	AHT21B_StopSampling();
+	interleave = 0u;
+	while(SIM_Consume(SIM_READ_MAX) > 0u) {}
+	SIM_Account(1u);
+
+	printf("  %u samplings, %u triggers, %u barriers interleaved\n", totals.samplingCount, sensor.triggerCount, totals.interleaveCount);
+	printf("  %u samples, %u overruns, %u skipped slots, %u errors, %u discarded at a restart\n", totals.statistics.sampleCount,
+			totals.statistics.overrunCount, totals.statistics.skippedCount, totals.statistics.errorCount, totals.discardCount);
+	printf("  %u read across a restart, %u stale, %u out of order, %u torn, %u bad timestamps, %u not accounted\n", consumer.lateCount,
+			consumer.staleCount, consumer.orderCount, consumer.tornCount, consumer.timeCount, totals.accountCount);
+	failCount += (int)(consumer.staleCount + consumer.orderCount + consumer.tornCount + consumer.timeCount + totals.accountCount);
+	failCount += (sensor.triggerCount >= SIM_TRIGGER_MAX);
+	failCount += (totals.statistics.overrunCount == 0u) + (totals.statistics.skippedCount == 0u) + (totals.statistics.errorCount == 0u);
+	failCount += (totals.discardCount == 0u) + (totals.interleaveCount == 0u);
+
+	return failCount;
+}
+
+/* Function Definition --------------------------------*/
+
+int main(void)
+{
+	int failCount = 0;
+
+	srand(7u);
+	failCount += SIM_Latency();
+	failCount += SIM_Conversion();
+	failCount += SIM_Sampling();
+	printf("%s\n", (failCount == 0) ? "PASS" : "FAIL");
+
+	return (failCount == 0) ? 0 : 1;
+}
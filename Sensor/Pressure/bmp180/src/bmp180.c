@@ -9,80 +9,369 @@
 #include "bmp180.h"
 #include "bmp180_cfg.h"
 
-/* Structures -----------------------------------------*/
-/* Structure to hold calibration coefficients */
-static st_CalibrationCoeff calibrationCoefficient =
-{
-	0u, /* AC1 */
-	0u, /* AC2 */
-	0u, /* AC3 */
-	0u, /* AC4 */
-	0u, /* AC5 */
-	0u, /* AC6 */
-	0u, /* B1 */
-	0u, /* B2 */
-	0u, /* MB */
-	0u, /* MC */
-	0u, /* MD */
-	0u, /* B3 */
-	0u, /* B4 */
-	0u, /* B5 */
-	0u, /* B6 */
-	0u, /* B7 */
-	ULTRA_LOW_POWER, /* Sampling Mode */
+/* Variables ------------------------------------------*/
+/* Maximum pressure conversion time of each sampling mode (in ms). Refer Data sheet */
+static const uint8_t pressureWaitTime[ULTRA_HIGH_RESOLUTION + 1u] = {5u, 8u, 14u, 26u};
+
+/* Lookup tables of the barometric formula, generated offline, the size is selected with BMP180_ALTITUDE_ACCURACY.
+ * altitudeTable:       44330 * (1 - (p/p0)^(1/5.255)) in cm, for p/p0 from 0.25 to 1.25 in equal steps.
+ * seaLevelFactorTable: (1 - h/44330)^-5.255 in Q16, for h from -1000 m to -1000 m + 2^20 cm in equal steps. */
+#if(BMP180_ALTITUDE_ACCURACY == BMP180_ACCURACY_LOW)
+#define BMP180_ALTITUDE_TABLE_SHIFT		6u
+static const int32_t altitudeTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	1027909, 988398, 950727, 914714, 880204, 847065, 815179, 784446,
+	754777, 726093, 698323, 671404, 645282, 619904, 595225, 571203,
+	547801, 524984, 502720, 480980, 459737, 438967, 418646, 398754,
+	379271, 360178, 341459, 323097, 305077, 287387, 270011, 252939,
+	236159, 219659, 203430, 187461, 171745, 156270, 141031, 126018,
+	111225, 96644, 82269, 68093, 54110, 40315, 26702, 13265,
+	0, -13098, -26034, -38813, -51438, -63913, -76243, -88431,
+	-100481, -112396, -124180, -135835, -147365, -158774, -170062, -181234,
+	-192293
+};
+static const int32_t seaLevelFactorTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	58287, 59406, 60552, 61724, 62922, 64149, 65404, 66689,
+	68004, 69349, 70727, 72137, 73581, 75059, 76573, 78124,
+	79711, 81338, 83004, 84711, 86459, 88251, 90088, 91970,
+	93899, 95876, 97903, 99981, 102112, 104297, 106538, 108837,
+	111195, 113614, 116096, 118643, 121256, 123939, 126692, 129518,
+	132420, 135400, 138459, 141602, 144829, 148145, 151551, 155051,
+	158647, 162343, 166142, 170048, 174063, 178191, 182437, 186804,
+	191295, 195916, 200670, 205562, 210597, 215779, 221114, 226606,
+	232262
+};
+#elif(BMP180_ALTITUDE_ACCURACY == BMP180_ACCURACY_MEDIUM)
+#define BMP180_ALTITUDE_TABLE_SHIFT		7u
+static const int32_t altitudeTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	1027909, 1007911, 988398, 969345, 950727, 932523, 914714, 897280,
+	880204, 863471, 847065, 830972, 815179, 799675, 784446, 769484,
+	754777, 740316, 726093, 712097, 698323, 684761, 671404, 658247,
+	645282, 632503, 619904, 607480, 595225, 583134, 571203, 559427,
+	547801, 536322, 524984, 513785, 502720, 491786, 480980, 470298,
+	459737, 449294, 438967, 428752, 418646, 408648, 398754, 388963,
+	379271, 369677, 360178, 350773, 341459, 332234, 323097, 314045,
+	305077, 296192, 287387, 278660, 270011, 261438, 252939, 244513,
+	236159, 227875, 219659, 211511, 203430, 195414, 187461, 179572,
+	171745, 163978, 156270, 148622, 141031, 133497, 126018, 118595,
+	111225, 103908, 96644, 89431, 82269, 75156, 68093, 61078,
+	54110, 47190, 40315, 33486, 26702, 19962, 13265, 6611,
+	0, -6570, -13098, -19586, -26034, -32443, -38813, -45144,
+	-51438, -57694, -63913, -70096, -76243, -82355, -88431, -94473,
+	-100481, -106455, -112396, -118304, -124180, -130023, -135835, -141616,
+	-147365, -153085, -158774, -164433, -170062, -175663, -181234, -186778,
+	-192293
+};
+static const int32_t seaLevelFactorTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	58287, 58843, 59406, 59976, 60552, 61134, 61724, 62320,
+	62922, 63532, 64149, 64773, 65404, 66043, 66689, 67343,
+	68004, 68673, 69349, 70034, 70727, 71428, 72137, 72855,
+	73581, 74316, 75059, 75812, 76573, 77344, 78124, 78913,
+	79711, 80520, 81338, 82166, 83004, 83852, 84711, 85580,
+	86459, 87350, 88251, 89164, 90088, 91023, 91970, 92928,
+	93899, 94881, 95876, 96883, 97903, 98935, 99981, 101040,
+	102112, 103198, 104297, 105411, 106538, 107681, 108837, 110009,
+	111195, 112397, 113614, 114847, 116096, 117361, 118643, 119941,
+	121256, 122589, 123939, 125306, 126692, 128096, 129518, 130960,
+	132420, 133900, 135400, 136919, 138459, 140020, 141602, 143205,
+	144829, 146476, 148145, 149836, 151551, 153289, 155051, 156836,
+	158647, 160482, 162343, 164230, 166142, 168082, 170048, 172041,
+	174063, 176113, 178191, 180299, 182437, 184605, 186804, 189034,
+	191295, 193589, 195916, 198276, 200670, 203099, 205562, 208062,
+	210597, 213169, 215779, 218427, 221114, 223840, 226606, 229413,
+	232262
 };
+#else /* BMP180_ACCURACY_HIGH */
+#define BMP180_ALTITUDE_TABLE_SHIFT		8u
+static const int32_t altitudeTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	1027909, 1017848, 1007911, 998096, 988398, 978816, 969345, 959983,
+	950727, 941575, 932523, 923571, 914714, 905951, 897280, 888698,
+	880204, 871796, 863471, 855228, 847065, 838980, 830972, 823039,
+	815179, 807392, 799675, 792027, 784446, 776933, 769484, 762099,
+	754777, 747517, 740316, 733175, 726093, 719067, 712097, 705183,
+	698323, 691516, 684761, 678057, 671404, 664801, 658247, 651741,
+	645282, 638869, 632503, 626181, 619904, 613670, 607480, 601331,
+	595225, 589159, 583134, 577149, 571203, 565296, 559427, 553596,
+	547801, 542043, 536322, 530635, 524984, 519367, 513785, 508236,
+	502720, 497237, 491786, 486367, 480980, 475624, 470298, 465003,
+	459737, 454501, 449294, 444116, 438967, 433845, 428752, 423685,
+	418646, 413634, 408648, 403688, 398754, 393846, 388963, 384104,
+	379271, 374462, 369677, 364916, 360178, 355464, 350773, 346104,
+	341459, 336835, 332234, 327655, 323097, 318560, 314045, 309551,
+	305077, 300624, 296192, 291779, 287387, 283014, 278660, 274326,
+	270011, 265715, 261438, 257180, 252939, 248717, 244513, 240327,
+	236159, 232008, 227875, 223758, 219659, 215577, 211511, 207463,
+	203430, 199414, 195414, 191430, 187461, 183509, 179572, 175651,
+	171745, 167854, 163978, 160117, 156270, 152439, 148622, 144819,
+	141031, 137257, 133497, 129751, 126018, 122300, 118595, 114903,
+	111225, 107560, 103908, 100270, 96644, 93031, 89431, 85844,
+	82269, 78706, 75156, 71619, 68093, 64579, 61078, 57588,
+	54110, 50644, 47190, 43747, 40315, 36895, 33486, 30088,
+	26702, 23326, 19962, 16608, 13265, 9933, 6611, 3300,
+	0, -3290, -6570, -9839, -13098, -16347, -19586, -22815,
+	-26034, -29244, -32443, -35633, -38813, -41983, -45144, -48296,
+	-51438, -54570, -57694, -60808, -63913, -67009, -70096, -73174,
+	-76243, -79303, -82355, -85397, -88431, -91456, -94473, -97481,
+	-100481, -103472, -106455, -109430, -112396, -115354, -118304, -121246,
+	-124180, -127106, -130023, -132933, -135835, -138729, -141616, -144494,
+	-147365, -150229, -153085, -155933, -158774, -161607, -164433, -167251,
+	-170062, -172866, -175663, -178452, -181234, -184010, -186778, -189539,
+	-192293
+};
+static const int32_t seaLevelFactorTable[POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1u] =
+{
+	58287, 58564, 58843, 59124, 59406, 59690, 59976, 60263,
+	60552, 60842, 61134, 61428, 61724, 62021, 62320, 62620,
+	62922, 63226, 63532, 63840, 64149, 64460, 64773, 65088,
+	65404, 65723, 66043, 66365, 66689, 67015, 67343, 67672,
+	68004, 68337, 68673, 69010, 69349, 69691, 70034, 70380,
+	70727, 71076, 71428, 71782, 72137, 72495, 72855, 73217,
+	73581, 73947, 74316, 74687, 75059, 75435, 75812, 76191,
+	76573, 76957, 77344, 77733, 78124, 78517, 78913, 79311,
+	79711, 80114, 80520, 80928, 81338, 81751, 82166, 82584,
+	83004, 83427, 83852, 84280, 84711, 85144, 85580, 86018,
+	86459, 86903, 87350, 87799, 88251, 88706, 89164, 89624,
+	90088, 90554, 91023, 91495, 91970, 92447, 92928, 93412,
+	93899, 94388, 94881, 95377, 95876, 96378, 96883, 97391,
+	97903, 98418, 98935, 99457, 99981, 100509, 101040, 101574,
+	102112, 102653, 103198, 103746, 104297, 104852, 105411, 105973,
+	106538, 107108, 107681, 108257, 108837, 109421, 110009, 110600,
+	111195, 111794, 112397, 113004, 113614, 114229, 114847, 115470,
+	116096, 116727, 117361, 118000, 118643, 119290, 119941, 120597,
+	121256, 121921, 122589, 123262, 123939, 124620, 125306, 125997,
+	126692, 127392, 128096, 128805, 129518, 130237, 130960, 131688,
+	132420, 133158, 133900, 134647, 135400, 136157, 136919, 137687,
+	138459, 139237, 140020, 140808, 141602, 142400, 143205, 144014,
+	144829, 145650, 146476, 147307, 148145, 148987, 149836, 150691,
+	151551, 152417, 153289, 154167, 155051, 155940, 156836, 157739,
+	158647, 159562, 160482, 161410, 162343, 163283, 164230, 165183,
+	166142, 167109, 168082, 169061, 170048, 171041, 172041, 173049,
+	174063, 175084, 176113, 177149, 178191, 179242, 180299, 181365,
+	182437, 183517, 184605, 185701, 186804, 187915, 189034, 190160,
+	191295, 192438, 193589, 194748, 195916, 197092, 198276, 199469,
+	200670, 201880, 203099, 204326, 205562, 206807, 208062, 209325,
+	210597, 211879, 213169, 214470, 215779, 217098, 218427, 219766,
+	221114, 222472, 223840, 225218, 226606, 228005, 229413, 230832,
+	232262
+};
+#endif
 
 /* Static Function Declaration ------------------------*/
 /**
  * @brief  Performs a soft reset of the BMP180 sensor.
  * @note   Resets the sensor using the soft reset register.
- * @param  None
+ * @param  bmp180  Context of the sensor.
  * @retval None
  */
-static void BMP180_SoftReset();
+static void BMP180_SoftReset(st_BMP180Handle *bmp180);
 
 /**
  * @brief  Reads the calibration coefficients from the BMP180 sensor.
  * @note   Reads configuration data from BMP180 and updates the calibration coefficients.
- * @param  None
+ * @param  bmp180  Context of the sensor.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+static e_Status BMP180_ReadCalibrationCoefficient(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Writes a measurement start command to the control register.
+ * @note   Starts the timing of the conversion for the completion detection.
+ * @param  bmp180  Context of the sensor.
+ * @param  controlValue  Value written in the control register (temperature or pressure start).
+ * @param  waitTime  Worst-case conversion time (in ms).
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-static e_Status BMP180_ReadCalibrationCoefficient();
+static e_Status BMP180_StartMeasurement(st_BMP180Handle *bmp180, uint8_t controlValue, uint32_t waitTime);
+
+/**
+ * @brief  Reads the raw temperature result of a finished conversion.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawTemp  Pointer to store the raw temperature value.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+static e_Status BMP180_ReadUncompensatedTemp(st_BMP180Handle *bmp180, int32_t *rawTemp);
+
+/**
+ * @brief  Reads the raw pressure result of a finished conversion.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawPressure  Pointer to store the raw pressure value.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+static e_Status BMP180_ReadUncompensatedPressure(st_BMP180Handle *bmp180, int32_t *rawPressure);
 
 /**
  * @brief  Gets the uncompensated temperature value from the BMP180 sensor.
  * @note   Reads the raw temperature data from the sensor.
+ * @param  bmp180  Context of the sensor.
  * @param  rawTemp  Pointer to store the raw temperature value.
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-static e_Status BMP180_GetUncompensatedTemp(int16_t *rawTemp);
+static e_Status BMP180_GetUncompensatedTemp(st_BMP180Handle *bmp180, int32_t *rawTemp);
 
 /**
  * @brief  Gets the uncompensated pressure value from the BMP180 sensor.
  * @note   Reads the raw pressure data from the sensor.
+ * @param  bmp180  Context of the sensor.
  * @param  rawPressure  Pointer to store the raw pressure value.
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-static e_Status BMP180_GetUncompensatedPressure(int16_t *rawPressure);
+static e_Status BMP180_GetUncompensatedPressure(st_BMP180Handle *bmp180, int32_t *rawPressure);
+
+/**
+ * @brief  Calculates the true temperature from the raw temperature.
+ * @note   Updates B5 in the calibration coefficient structure, needed by the pressure compensation,
+ *         and refreshes the temperature cache.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawTemp  Raw temperature value.
+ * @retval float  Temperature in Celsius.
+ */
+static float BMP180_CompensateTemperature(st_BMP180Handle *bmp180, int32_t rawTemp);
+
+/**
+ * @brief  Calculates the compensation terms depending only on the calibration and sampling mode.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+static void BMP180_BuildCompensationTable(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Calculates the terms of the pressure compensation depending only on B5.
+ * @note   Updates B6, B3, B4 and the reciprocal of B4. Called on every B5 refresh.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+static void BMP180_UpdatePressureTerms(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Divides by B4 using its reciprocal.
+ * @note   Exact unsigned division with a multiply and at most two corrections, as the Cortex-M0
+ *         has no hardware divider.
+ * @param  bmp180  Context of the sensor.
+ * @param  dividend  Value to divide.
+ * @retval uint32_t  dividend / B4.
+ */
+static uint32_t BMP180_DivideByB4(st_BMP180Handle *bmp180, uint32_t dividend);
+
+/**
+ * @brief  Calculates the true pressure of one sample from the raw pressure.
+ * @note   Uses B3 and B4 of BMP180_UpdatePressureTerms(), only multiplications and shifts.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawPressure  Raw pressure value.
+ * @retval int32_t  Pressure in Pa.
+ */
+static int32_t BMP180_CompensatePressureSample(st_BMP180Handle *bmp180, int32_t rawPressure);
+
+/**
+ * @brief  Calculates the true pressure from the raw pressure.
+ * @note   Uses B5 of the last temperature compensation and counts the sample against the cache.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawPressure  Raw pressure value.
+ * @retval int32_t  Pressure in Pa.
+ */
+static int32_t BMP180_CompensatePressure(st_BMP180Handle *bmp180, int32_t rawPressure);
+
+/**
+ * @brief  Calculates the true pressure of a batch of raw pressures in one pass.
+ * @note   The terms depending on B5 are calculated once for the whole batch.
+ * @param  bmp180  Context of the sensor.
+ * @param  samples  Raw pressure values, replaced by the pressure in Pa.
+ * @param  sampleCount  Number of samples.
+ * @retval None
+ */
+static void BMP180_CompensatePressureBatch(st_BMP180Handle *bmp180, int32_t *samples, uint8_t sampleCount);
+
+/**
+ * @brief  Feeds one pressure sample to the running filter.
+ * @param  bmp180  Context of the sensor.
+ * @param  pressure  Pressure in Pa.
+ * @retval None
+ */
+static void BMP180_FilterSample(st_BMP180Handle *bmp180, int32_t pressure);
+
+/**
+ * @brief  Calculates the rate and noise of the completed burst.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+static void BMP180_UpdateBurstStatistics(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Stores a burst sample and chains the next conversion or completes the burst.
+ * @param  bmp180  Context of the sensor.
+ * @param  rawPressure  Raw pressure value.
+ * @retval e_Status  STATUS_BUSY if more conversions follow, STATUS_OK when the burst is complete,
+ *                   STATUS_NOT_OK on error.
+ */
+static e_Status BMP180_ProcessBurstSample(st_BMP180Handle *bmp180, int32_t rawPressure);
+
+/**
+ * @brief  Interpolates linearly between the entries of an altitude lookup table.
+ * @param  table  Lookup table of POWER_OF_2(BMP180_ALTITUDE_TABLE_SHIFT) + 1 entries.
+ * @param  position  Position in the table span, 0 to 2^BMP180_TABLE_SPAN_SHIFT - 1.
+ * @retval int32_t  Interpolated value.
+ */
+static int32_t BMP180_InterpolateTable(const int32_t *table, uint32_t position);
+
+/**
+ * @brief  Calculates the integer square root.
+ * @param  value  Input value.
+ * @retval uint32_t  Square root rounded down.
+ */
+static uint32_t BMP180_SquareRoot(uint64_t value);
+
+/**
+ * @brief  Checks if the cached B5 can be used for the next pressure sample.
+ * @note   Refer BMP180_TEMP_REFRESH_SAMPLES and BMP180_TEMP_REFRESH_AGE in bmp180_cfg.h.
+ * @param  bmp180  Context of the sensor.
+ * @retval uint8_t  1 if valid, 0 if the temperature has to be converted again.
+ */
+static uint8_t BMP180_IsTemperatureCacheValid(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Starts the pressure conversion of the non-blocking conversion.
+ * @param  bmp180  Context of the sensor.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+static e_Status BMP180_StartPressureConversion(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Checks if the conversion in progress is complete.
+ * @note   Uses the completion mode of the sensor, bounded by the worst-case conversion time.
+ *         Updates the latency statistics when the conversion is complete.
+ * @param  bmp180  Context of the sensor.
+ * @retval uint8_t  1 if complete, 0 otherwise.
+ */
+static uint8_t BMP180_IsConversionComplete(st_BMP180Handle *bmp180);
+
+/**
+ * @brief  Waits until the conversion in progress is complete.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+static void BMP180_WaitForConversion(st_BMP180Handle *bmp180);
 
 
 /* Static Function Definition -------------------------*/
-static void BMP180_SoftReset()
+static void BMP180_SoftReset(st_BMP180Handle *bmp180)
 {
 	uint8_t softReset = BMP180_SOFT_RESET_VALUE;
 
 	/* Write the soft reset command to the soft reset register of the sensor */
-	(void)BMP180_MemoryWrite(BMP180_WRITE_ADDRESS, BMP180_SOFT_RESET_REGISTER, &softReset, 0x01u);
+	(void)BMP180_MemoryWrite(bmp180->i2cHandle, bmp180->deviceAddress, BMP180_SOFT_RESET_REGISTER, &softReset, 0x01u);
 }
 
 
-static e_Status BMP180_ReadCalibrationCoefficient()
+static e_Status BMP180_ReadCalibrationCoefficient(st_BMP180Handle *bmp180)
 {
 	e_Status returnStatus = STATUS_NOT_OK;
 	uint8_t sensorCalibrationValues[BMP180_CALIBRATION_SIZE] = {0x00u}; /* Array to store calibration values read from the sensor */
 
 	/*Read configuration data from BMP180*/
-	returnStatus = BMP180_MemoryRead(BMP180_READ_ADDRESS, BMP180_CALIBRATION_REGISTER, sensorCalibrationValues, BMP180_CALIBRATION_SIZE);
+	returnStatus = BMP180_MemoryRead(bmp180->i2cHandle, (bmp180->deviceAddress | BMP180_READ_BIT), BMP180_CALIBRATION_REGISTER, sensorCalibrationValues, BMP180_CALIBRATION_SIZE);
 
 	/* Check if the read operation was successful */
 	if(returnStatus == STATUS_OK)
@@ -99,7 +388,7 @@ static e_Status BMP180_ReadCalibrationCoefficient()
 			if( (localCalibrationData != 0x0000u) || (localCalibrationData != 0xFFFFu) )
 			{
 				/* Update the calibration coefficient structure */
-				*(&calibrationCoefficient.AC1 + (i/2)) = localCalibrationData;
+				*(&bmp180->calibration.AC1 + (i/2)) = localCalibrationData;
 			}
 			else
 			{
@@ -117,26 +406,65 @@ static e_Status BMP180_ReadCalibrationCoefficient()
 	return returnStatus;
 }
 
-static e_Status BMP180_GetUncompensatedTemp(int16_t *rawTemp)
+static e_Status BMP180_StartMeasurement(st_BMP180Handle *bmp180, uint8_t controlValue, uint32_t waitTime)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	/* Clear the EOC flag before the start, the interrupt can come before the write returns */
+	bmp180->conversion.eocFlag = 0u;
+
+	/* Write the start command to the control register */
+	returnValue = BMP180_MemoryWrite(bmp180->i2cHandle, bmp180->deviceAddress, BMP180_CONTROL_REGISTER, &controlValue, 0x01u);
+
+	bmp180->conversion.startTick = COMMON_GET_TICK();
+	bmp180->conversion.waitTime = waitTime;
+
+	return returnValue;
+}
+
+static e_Status BMP180_ReadUncompensatedTemp(st_BMP180Handle *bmp180, int32_t *rawTemp)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t tempStart = BMP180_TEMPERATURE_START;
 	uint8_t rawTempArr[2u] = {0x00u}; /* Array to store the raw temperature values read from the sensor */
 
+	/* Read the raw temperature values from the sensor */
+	returnValue = BMP180_MemoryRead(bmp180->i2cHandle, (bmp180->deviceAddress | BMP180_READ_BIT), BMP180_OUT_MSB_REGISTER, rawTempArr, 0x02u);
+
+	/* Convert 8-bit values to 16-bit raw temperature data */
+	*rawTemp = CONVERT_8BITS_TO_16BITS(rawTempArr[0u], rawTempArr[1u]);
+
+	return returnValue;
+}
+
+static e_Status BMP180_ReadUncompensatedPressure(st_BMP180Handle *bmp180, int32_t *rawPressure)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t rawPressureArr[3u] = {0x00}; /* Array to store the raw pressure values read from the sensor */
+
+	/* Read the raw pressure values from the sensor */
+	returnValue = BMP180_MemoryRead(bmp180->i2cHandle, (bmp180->deviceAddress | BMP180_READ_BIT), BMP180_OUT_MSB_REGISTER, rawPressureArr, 0x03u);
+
+	/* Convert MSB, LSB and XLSB to the 16 to 19-bit raw pressure data with sampling mode adjustment */
+	*rawPressure = ( ((int32_t)rawPressureArr[0u] << 16u) + ((int32_t)rawPressureArr[1u] << 8u) + rawPressureArr[2u] ) >> (8u - bmp180->calibration.samplingMode);
+
+	return returnValue;
+}
+
+static e_Status BMP180_GetUncompensatedTemp(st_BMP180Handle *bmp180, int32_t *rawTemp)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
 	/* Check if the rawTemp pointer is not NULL */
 	if(rawTemp != NULL)
 	{
 		/* Write the start command to the control register */
-		returnValue = BMP180_MemoryWrite(BMP180_WRITE_ADDRESS, BMP180_CONTROL_REGISTER, &tempStart, 0x01u);
+		returnValue = BMP180_StartMeasurement(bmp180, BMP180_TEMPERATURE_START, BMP180_WAIT_TIME);
 
 		/* Wait for the measurement to complete */
-		COMMON_DELAY(BMP180_WAIT_TIME);
+		BMP180_WaitForConversion(bmp180);
 
 		/* Read the raw temperature values from the sensor */
-		returnValue = BMP180_MemoryRead(BMP180_READ_ADDRESS, BMP180_OUT_MSB_REGISTER, rawTempArr, 0x02u);
-
-		/* Convert 8-bit values to 16-bit raw temperature data */
-		*rawTemp = CONVERT_8BITS_TO_16BITS(rawTempArr[0u], rawTempArr[1u]);
+		returnValue = BMP180_ReadUncompensatedTemp(bmp180, rawTemp);
 	}
 	else
 	{
@@ -146,28 +474,21 @@ static e_Status BMP180_GetUncompensatedTemp(int16_t *rawTemp)
 	return returnValue;
 }
 
-static e_Status BMP180_GetUncompensatedPressure(int16_t *rawPressure)
+static e_Status BMP180_GetUncompensatedPressure(st_BMP180Handle *bmp180, int32_t *rawPressure)
 {
 	e_Status returnValue = STATUS_NOT_OK;
-	uint8_t pressureValue = BMP180_PRESSURE_START + (calibrationCoefficient.samplingMode << 6u);
-
-	/* Calculate the wait time for pressure measurement. Refer Data sheet for explanation */
-	uint8_t waitTime = BMP180_WAIT_TIME + (calibrationCoefficient.samplingMode * 4u);
-	uint8_t rawPressureArr[3u] = {0x00}; /* Array to store the raw pressure values read from the sensor */
+	uint8_t pressureValue = BMP180_PRESSURE_START + (bmp180->calibration.samplingMode << 6u);
 
 	if(rawPressure != NULL)
 	{
 		/* Write the start command to the control register */
-		returnValue = BMP180_MemoryWrite(BMP180_WRITE_ADDRESS, BMP180_CONTROL_REGISTER, &pressureValue, 0x01u);
+		returnValue = BMP180_StartMeasurement(bmp180, pressureValue, pressureWaitTime[bmp180->calibration.samplingMode]);
 
 		/* Wait for the measurement to complete */
-		COMMON_DELAY(waitTime);
+		BMP180_WaitForConversion(bmp180);
 
 		/* Read the raw pressure values from the sensor */
-		returnValue = BMP180_MemoryRead(BMP180_READ_ADDRESS, BMP180_OUT_MSB_REGISTER, rawPressureArr, 0x03u);
-
-		/* Convert 8-bit values to 16-bit raw pressure data with sampling mode adjustment */
-		*rawPressure = ( (rawPressureArr[0u]<<16u) + (rawPressureArr[1u]<<8u) + rawPressureArr[3u]) >> (8u - calibrationCoefficient.samplingMode);
+		returnValue = BMP180_ReadUncompensatedPressure(bmp180, rawPressure);
 	}
 
 	else
@@ -178,132 +499,919 @@ static e_Status BMP180_GetUncompensatedPressure(int16_t *rawPressure)
 	return returnValue;
 }
 
+static float BMP180_CompensateTemperature(st_BMP180Handle *bmp180, int32_t rawTemp)
+{
+	int32_t X1 = 0;
+	int32_t X2 = 0;
+	int32_t denominator = 0;
+
+	/* Refer data sheet for the temperature algorithm. (UT - AC6) * AC5 can exceed 31 bits over the full UT range */
+	X1 = (int32_t)( ((int64_t)(rawTemp - bmp180->calibration.AC6) * bmp180->calibration.AC5) >> 15u );
+	denominator = X1 + bmp180->calibration.MD;
+	X2 = (denominator != 0) ? (bmp180->compensation.MCx2048 / denominator) : 0;
+	bmp180->calibration.B5 = X1 + X2;
+
+	/* Terms of the pressure compensation only change with B5 */
+	BMP180_UpdatePressureTerms(bmp180);
+
+	/* B5 is fresh, restart the cache limits */
+	bmp180->temperatureCache.valid = 1u;
+	bmp180->temperatureCache.sampleCount = 0u;
+	bmp180->temperatureCache.refreshTick = COMMON_GET_TICK();
+	bmp180->temperatureCache.temperature = ((bmp180->calibration.B5 + 8) >> 4u) / 10.0f;
+
+	return bmp180->temperatureCache.temperature;
+}
+
+static void BMP180_BuildCompensationTable(st_BMP180Handle *bmp180)
+{
+	bmp180->compensation.AC1x4 = (int32_t)bmp180->calibration.AC1 * 4;
+	bmp180->compensation.MCx2048 = (int32_t)bmp180->calibration.MC * POWER_OF_2(11);
+	bmp180->compensation.B7Factor = 50000u >> bmp180->calibration.samplingMode;
+}
+
+static void BMP180_UpdatePressureTerms(st_BMP180Handle *bmp180)
+{
+	int32_t X1 = 0;
+	int32_t X2 = 0;
+	int32_t X3 = 0;
+	int32_t B6Square = 0;
+
+	/* Refer data sheet for the pressure algorithm. Divisions by 2^n are arithmetic shifts as in the
+	 * data sheet example. All intermediates stay within 32 bits over the operating range (B6 within +/-2^14) */
+	bmp180->calibration.B6 = bmp180->calibration.B5 - 4000;
+	B6Square = (bmp180->calibration.B6 * bmp180->calibration.B6) >> 12u;
+	X1 = (bmp180->calibration.B2 * B6Square) >> 11u;
+	X2 = (bmp180->calibration.AC2 * bmp180->calibration.B6) >> 11u;
+	X3 = X1 + X2;
+	bmp180->calibration.B3 = (((bmp180->compensation.AC1x4 + X3) << bmp180->calibration.samplingMode) + 2) >> 2u;
+	X1 = (bmp180->calibration.AC3 * bmp180->calibration.B6) >> 13u;
+	X2 = (bmp180->calibration.B1 * B6Square) >> 16u;
+	X3 = ((X1 + X2) + 2) >> 2u;
+	bmp180->calibration.B4 = (bmp180->calibration.AC4 * (uint32_t)(X3 + 32768)) >> 15u;
 
-/* Function Definition --------------------------------*/
-e_Status BMP180_Init()
+	/* One division per B5 refresh instead of one per sample */
+	bmp180->compensation.B4Reciprocal = (bmp180->calibration.B4 != 0u) ? (0xFFFFFFFFu / bmp180->calibration.B4) : 0u;
+}
+
+static uint32_t BMP180_DivideByB4(st_BMP180Handle *bmp180, uint32_t dividend)
 {
-	e_Status returnStatus = STATUS_NOT_OK;
+	uint32_t quotient = 0u;
+	uint32_t B4 = bmp180->calibration.B4;
+
+	if(B4 != 0u)
+	{
+		/* The estimate from the reciprocal is at most 2 below the true quotient, correct it */
+		quotient = (uint32_t)( ((uint64_t)dividend * bmp180->compensation.B4Reciprocal) >> 32u );
+		while( (dividend - (quotient * B4)) >= B4 )
+		{
+			quotient++;
+		}
+	}
 
-	/* Perform a soft reset of the sensor and wait*/
-	BMP180_SoftReset();
-	COMMON_DELAY(10);
+	return quotient;
+}
+
+static int32_t BMP180_CompensatePressureSample(st_BMP180Handle *bmp180, int32_t rawPressure)
+{
+	int32_t X1 = 0;
+	int32_t X2 = 0;
+	int32_t p = 0;
 
-	/* Check if the sensor is ready */
-	returnStatus = BMP180_IsDeviceReady(BMP180_READ_ADDRESS);
+	/* Refer data sheet for the pressure algorithm */
+	bmp180->calibration.B7 = ((uint32_t)rawPressure - bmp180->calibration.B3) * bmp180->compensation.B7Factor;
 
-	/* If the sensor is ready, read calibration coefficients and set sampling mode */
-	if (returnStatus == STATUS_OK)
+	if(bmp180->calibration.B7 < 0x80000000)
 	{
-		returnStatus = BMP180_ReadCalibrationCoefficient();
-		BMP180_SetSamplingMode(ULTRA_LOW_POWER);
+		p = BMP180_DivideByB4(bmp180, bmp180->calibration.B7 * 2u);
 	}
 	else
 	{
-        /* Handle error case */
+		p = BMP180_DivideByB4(bmp180, bmp180->calibration.B7) * 2u;
 	}
 
-	return returnStatus;
+	/* Fits in 32 bits for p below 2^17 Pa, beyond the 300 - 1100 hPa range of the sensor */
+	X1 = (p >> 8u) * (p >> 8u);
+	X1 = (X1 * 3038) >> 16u;
+	X2 = (-7357 * p) >> 16u;
+
+	return p + ((X1 + X2 + 3791) >> 4u);
+}
+
+static int32_t BMP180_CompensatePressure(st_BMP180Handle *bmp180, int32_t rawPressure)
+{
+	bmp180->temperatureCache.sampleCount++;
+
+	return BMP180_CompensatePressureSample(bmp180, rawPressure);
 }
 
+static void BMP180_CompensatePressureBatch(st_BMP180Handle *bmp180, int32_t *samples, uint8_t sampleCount)
+{
+	bmp180->temperatureCache.sampleCount += sampleCount;
+
+	/* B5 is the same for the whole batch, only the per sample part is repeated */
+	for(uint8_t i = 0u; i < sampleCount; i++)
+	{
+		samples[i] = BMP180_CompensatePressureSample(bmp180, samples[i]);
+	}
+}
 
-void BMP180_DeInit()
+static void BMP180_FilterSample(st_BMP180Handle *bmp180, int32_t pressure)
 {
-	/* Perform a soft reset of the sensor */
-	BMP180_SoftReset();
+	st_PressureFilter *filter = &bmp180->filter;
+	int32_t sortedWindow[BMP180_FILTER_MAX_SIZE] = {0};
+	int32_t sortValue = 0;
+	uint8_t i = 0u;
+	uint8_t j = 0u;
+
+	switch(filter->type)
+	{
+		case BMP180_FILTER_MOVING_AVERAGE:
+			/* Replace the oldest sample of the window in the running sum */
+			if(filter->count == filter->parameter)
+			{
+				filter->sum -= filter->window[filter->index];
+			}
+			else
+			{
+				filter->count++;
+			}
+			filter->window[filter->index] = pressure;
+			filter->sum += pressure;
+			filter->index = (filter->index + 1u) % filter->parameter;
+			filter->output = filter->sum / filter->count;
+			break;
+
+		case BMP180_FILTER_IIR:
+			/* output += (pressure - output) / 2^parameter, kept scaled to avoid losing the fraction */
+			if(filter->count == 0u)
+			{
+				filter->iirState = pressure * POWER_OF_2(filter->parameter);
+				filter->count = 1u;
+			}
+			else
+			{
+				filter->iirState += pressure - (filter->iirState >> filter->parameter);
+			}
+			filter->output = filter->iirState >> filter->parameter;
+			break;
+
+		case BMP180_FILTER_MEDIAN:
+			if(filter->count < filter->parameter)
+			{
+				filter->count++;
+			}
+			filter->window[filter->index] = pressure;
+			filter->index = (filter->index + 1u) % filter->parameter;
+
+			/* Insertion sort of a copy of the window, the window is small */
+			for(i = 0u; i < filter->count; i++)
+			{
+				sortValue = filter->window[i];
+				for(j = i; (j > 0u) && (sortedWindow[j - 1u] > sortValue); j--)
+				{
+					sortedWindow[j] = sortedWindow[j - 1u];
+				}
+				sortedWindow[j] = sortValue;
+			}
+			filter->output = sortedWindow[filter->count / 2u];
+			break;
+
+		default: /* No filter */
+			filter->output = pressure;
+			break;
+	}
 }
 
+static void BMP180_UpdateBurstStatistics(st_BMP180Handle *bmp180)
+{
+	st_BurstStatistics *statistics = &bmp180->burst.statistics;
+	int64_t sum = 0;
+	int64_t sumSquares = 0;
+	int64_t variance = 0;
+	uint8_t sampleCount = bmp180->burst.count;
+
+	statistics->sampleCount = sampleCount;
+	statistics->elapsedTime = COMMON_GET_TICK() - bmp180->burst.startTick;
+	statistics->samplesPerSecond = (statistics->elapsedTime != 0u) ? ((sampleCount * 1000u) / statistics->elapsedTime) : 0u;
+	statistics->minimum = bmp180->burst.samples[0u];
+	statistics->maximum = bmp180->burst.samples[0u];
+
+	for(uint8_t i = 0u; i < sampleCount; i++)
+	{
+		sum += bmp180->burst.samples[i];
+		sumSquares += (int64_t)bmp180->burst.samples[i] * bmp180->burst.samples[i];
+
+		if(bmp180->burst.samples[i] < statistics->minimum)
+		{
+			statistics->minimum = bmp180->burst.samples[i];
+		}
+		if(bmp180->burst.samples[i] > statistics->maximum)
+		{
+			statistics->maximum = bmp180->burst.samples[i];
+		}
+	}
+
+	/* variance = (n*sum(p^2) - sum(p)^2) / n^2, scaled to report the noise in 0.01 Pa */
+	statistics->mean = (int32_t)(sum / sampleCount);
+	variance = ((sampleCount * sumSquares) - (sum * sum)) * (BMP180_NOISE_SCALE * BMP180_NOISE_SCALE);
+	variance /= ((int64_t)sampleCount * sampleCount);
+	statistics->noise = BMP180_SquareRoot((uint64_t)variance);
+}
 
-e_Status BMP180_ReadTemperature(float *tempValue)
+static e_Status BMP180_ProcessBurstSample(st_BMP180Handle *bmp180, int32_t rawPressure)
 {
-	e_Status returnValue = STATUS_NOT_OK;
-	int16_t rawTemp = 0;
-	int16_t X1 = 0;
-	int16_t X2 = 0;
+	e_Status returnValue = STATUS_BUSY;
 
-	/* Get the raw temperature value from the sensor */
-	returnValue = BMP180_GetUncompensatedTemp(&rawTemp);
+	bmp180->burst.samples[bmp180->burst.count] = rawPressure;
+	bmp180->burst.count++;
 
-	/* Check if the tempValue pointer is not NULL and the read operation was successful */
-	if( (tempValue != NULL) && (returnValue == STATUS_OK) )
+	if(bmp180->burst.count < bmp180->burst.size)
 	{
-		/* Refer data sheet for the temperature algorithm */
-		X1 = ( (rawTemp - calibrationCoefficient.AC6) *  calibrationCoefficient.AC5 ) / POWER_OF_2(15) ;
-		X2 = (calibrationCoefficient.MC * POWER_OF_2(11)) / (X1 + calibrationCoefficient.MD);
-		calibrationCoefficient.B5 = X1 + X2;
-		*tempValue = ((calibrationCoefficient.B5 +8) / POWER_OF_2(4)) / 10.0f ;
+		/* Chain the next conversion right away, B5 is reused for the whole burst */
+		if(BMP180_StartPressureConversion(bmp180) != STATUS_OK)
+		{
+			returnValue = STATUS_NOT_OK;
+		}
 	}
 	else
 	{
-        /* Handle null pointer or error case */
+		BMP180_CompensatePressureBatch(bmp180, bmp180->burst.samples, bmp180->burst.count);
+
+		for(uint8_t i = 0u; i < bmp180->burst.count; i++)
+		{
+			BMP180_FilterSample(bmp180, bmp180->burst.samples[i]);
+		}
+
+		BMP180_UpdateBurstStatistics(bmp180);
+
+		bmp180->conversion.pressure = bmp180->filter.output;
+		bmp180->conversion.state = BMP180_STATE_DONE;
+		returnValue = STATUS_OK;
 	}
 
 	return returnValue;
 }
 
-e_Status BMP180_ReadPressure(int32_t *pressureValue)
+static int32_t BMP180_InterpolateTable(const int32_t *table, uint32_t position)
 {
-	e_Status returnValue = STATUS_NOT_OK;
-	float getTemp = 0.0f;
-	int16_t rawPressure = 0;
-	int16_t X1 = 0;
-	int16_t X2 = 0;
-	int16_t X3 = 0;
-	int32_t p = 0;
+	uint8_t fractionBits = BMP180_TABLE_SPAN_SHIFT - BMP180_ALTITUDE_TABLE_SHIFT;
+	uint32_t index = position >> fractionBits;
+	int32_t fraction = (int32_t)(position & (POWER_OF_2(fractionBits) - 1u));
+
+	/* Step between two entries times the fraction stays within 32 bits for every table size */
+	return table[index] + (((table[index + 1u] - table[index]) * fraction) >> fractionBits);
+}
+
+static uint32_t BMP180_SquareRoot(uint64_t value)
+{
+	uint64_t result = 0u;
+	uint64_t bit = (uint64_t)1u << 62u;
+
+	/* Bit by bit method, no division needed */
+	while(bit > value)
+	{
+		bit >>= 2u;
+	}
 
-	/* Read the temperature value  and raw pressure value from the sensor*/
-	returnValue = BMP180_ReadTemperature(&getTemp);
-	returnValue = BMP180_GetUncompensatedPressure(&rawPressure);
-
-	/* Check if the pressureValue pointer is not NULL and the read operation was successful */
-	if( (pressureValue != NULL) && (returnValue == STATUS_OK))
-	{
-		/* Refer data sheet for the pressure algorithm */
-		calibrationCoefficient.B6 = calibrationCoefficient.B5 - 4000;
-		X1 = ( calibrationCoefficient.B2 * (calibrationCoefficient.B6 * calibrationCoefficient.B6/ POWER_OF_2(12)) ) / POWER_OF_2(11);
-		X2 = calibrationCoefficient.AC2 * calibrationCoefficient.B6 / POWER_OF_2(11);
-		X3 = X1 + X2;
-		calibrationCoefficient.B3 = ((((calibrationCoefficient.AC1 * 4) + X3) << calibrationCoefficient.samplingMode) + 2u )/ 4u;
-		X1 = calibrationCoefficient.AC3 * calibrationCoefficient.B6 / POWER_OF_2(13);
-		X2 = (calibrationCoefficient.B1 * (calibrationCoefficient.B6 * calibrationCoefficient.B6 / POWER_OF_2(12))) / POWER_OF_2(16);
-		X3 = ((X1 + X2) + 2) / POWER_OF_2(2);
-		calibrationCoefficient.B4 = calibrationCoefficient.AC4 * (uint32_t)(X3 + 32768) / POWER_OF_2(15);
-		calibrationCoefficient.B7 = ((uint32_t)rawPressure - calibrationCoefficient.B3) * (50000 >> calibrationCoefficient.samplingMode);
-
-		if(calibrationCoefficient.B7 < 0x80000000)
+	while(bit != 0u)
+	{
+		if(value >= (result + bit))
 		{
-			p = (calibrationCoefficient.B7 * 2) / calibrationCoefficient.B4;
+			value -= result + bit;
+			result = (result >> 1u) + bit;
 		}
 		else
 		{
-			p = (calibrationCoefficient.B7 / calibrationCoefficient.B4) * 2;
+			result >>= 1u;
 		}
+		bit >>= 2u;
+	}
+
+	return (uint32_t)result;
+}
+
+static uint8_t BMP180_IsTemperatureCacheValid(st_BMP180Handle *bmp180)
+{
+	uint8_t isValid = bmp180->temperatureCache.valid;
+
+	/* Refresh after the configured number of pressure samples */
+	if(bmp180->temperatureCache.sampleCount >= BMP180_TEMP_REFRESH_SAMPLES)
+	{
+		isValid = 0u;
+	}
+
+#if(BMP180_TEMP_REFRESH_AGE != 0u) /* Can be enabled and disabled in bmp180_cfg.h */
+	/* Refresh when B5 gets too old */
+	if( (uint32_t)(COMMON_GET_TICK() - bmp180->temperatureCache.refreshTick) >= BMP180_TEMP_REFRESH_AGE )
+	{
+		isValid = 0u;
+	}
+#endif
+
+	return isValid;
+}
 
-		X1 = (p/ POWER_OF_2(8)) * (p/ POWER_OF_2(8));
-		X1 = (X1 * 3038) / POWER_OF_2(16);
-		X2 = (-7357 * p)/ POWER_OF_2(16);
-		*pressureValue = p + ( (X1 + X2 + 3791) / POWER_OF_2(4));
+static e_Status BMP180_StartPressureConversion(st_BMP180Handle *bmp180)
+{
+	e_Status returnValue = STATUS_NOT_OK;
 
+	returnValue = BMP180_StartMeasurement(bmp180, BMP180_PRESSURE_START + (bmp180->calibration.samplingMode << 6u), pressureWaitTime[bmp180->calibration.samplingMode]);
+
+	if(returnValue == STATUS_OK)
+	{
+		bmp180->conversion.state = BMP180_STATE_PRESSURE;
 	}
 	else
 	{
-		/* Handle null pointer or error case */
+		bmp180->conversion.state = BMP180_STATE_ERROR;
 	}
 
 	return returnValue;
 }
 
-void BMP180_SetSamplingMode(e_SamplingMode samplingMode)
+static uint8_t BMP180_IsConversionComplete(st_BMP180Handle *bmp180)
 {
-	/* Update the sampling mode in the calibration coefficient structure */
-	calibrationCoefficient.samplingMode = samplingMode;
+	uint8_t isComplete = 0u;
+	uint8_t controlValue = BMP180_CONTROL_SCO_BIT;
+	uint32_t latency = COMMON_GET_TICK() - bmp180->conversion.startTick;
+	st_LatencyStatistics *statistics = &bmp180->latency[bmp180->completionMode];
+
+	switch(bmp180->completionMode)
+	{
+		case BMP180_COMPLETION_SCO:
+			/* SCO stays set while the conversion is running */
+			if(BMP180_MemoryRead(bmp180->i2cHandle, (bmp180->deviceAddress | BMP180_READ_BIT), BMP180_CONTROL_REGISTER, &controlValue, 0x01u) == STATUS_OK)
+			{
+				isComplete = ((controlValue & BMP180_CONTROL_SCO_BIT) == 0u) ? 1u : 0u;
+			}
+			break;
+
+		case BMP180_COMPLETION_EOC:
+			isComplete = bmp180->conversion.eocFlag;
+			break;
+
+		default: /* Fixed delay, only the worst-case conversion time below */
+			break;
+	}
+
+	/* Strictly greater than, as the first tick can come right after the start command */
+	if(latency > bmp180->conversion.waitTime)
+	{
+		isComplete = 1u;
+	}
+
+	if(isComplete == 1u)
+	{
+		if( (statistics->conversionCount == 0u) || (latency < statistics->minimum) )
+		{
+			statistics->minimum = latency;
+		}
+		if(latency > statistics->maximum)
+		{
+			statistics->maximum = latency;
+		}
+		statistics->total += latency;
+		statistics->conversionCount++;
+	}
+
+	return isComplete;
 }
 
-e_SamplingMode BMP180_GetSamplingMode()
+static void BMP180_WaitForConversion(st_BMP180Handle *bmp180)
 {
-	/* Return the current sampling mode from the calibration coefficient structure */
-	return calibrationCoefficient.samplingMode;
+	while(BMP180_IsConversionComplete(bmp180) == 0u)
+	{
+		/* Wait for the measurement to complete */
+	}
 }
 
 
+/* Function Definition --------------------------------*/
+e_Status BMP180_Init(st_BMP180Handle *bmp180, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress)
+{
+	e_Status returnStatus = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (i2cHandle != NULL) )
+	{
+		/* Bind the context to its bus and start from a clean state */
+		bmp180->i2cHandle = i2cHandle;
+		bmp180->deviceAddress = deviceAddress;
+		bmp180->conversion.state = BMP180_STATE_IDLE;
+		bmp180->burst.size = 0u;
+		(void)BMP180_SetFilter(bmp180, BMP180_FILTER_NONE, 1u);
+		(void)BMP180_SetSeaLevelPressure(bmp180, BMP180_SEA_LEVEL_PRESSURE);
+		bmp180->completionMode = BMP180_COMPLETION_DELAY;
+		BMP180_ResetLatencyStatistics(bmp180);
+
+		/* Perform a soft reset of the sensor and wait*/
+		BMP180_SoftReset(bmp180);
+		COMMON_DELAY(10);
+		BMP180_InvalidateTemperatureCache(bmp180);
+
+		/* Check if the sensor is ready */
+		returnStatus = BMP180_IsDeviceReady(bmp180->i2cHandle, (bmp180->deviceAddress | BMP180_READ_BIT));
 
+		/* If the sensor is ready, read calibration coefficients and set sampling mode */
+		if (returnStatus == STATUS_OK)
+		{
+			returnStatus = BMP180_ReadCalibrationCoefficient(bmp180);
+			BMP180_SetSamplingMode(bmp180, ULTRA_LOW_POWER);
+		}
+		else
+		{
+			/* Handle error case */
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
 
+	return returnStatus;
+}
+
+
+void BMP180_DeInit(st_BMP180Handle *bmp180)
+{
+	if(bmp180 != NULL)
+	{
+		/* Perform a soft reset of the sensor */
+		BMP180_SoftReset(bmp180);
+		bmp180->conversion.state = BMP180_STATE_IDLE;
+	}
+}
+
+
+e_Status BMP180_ReadTemperature(st_BMP180Handle *bmp180, float *tempValue)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	int32_t rawTemp = 0;
+
+	/* Check if the pointers are not NULL */
+	if( (bmp180 != NULL) && (tempValue != NULL) )
+	{
+		/* Get the raw temperature value from the sensor */
+		returnValue = BMP180_GetUncompensatedTemp(bmp180, &rawTemp);
+
+		/* Check if the read operation was successful */
+		if(returnValue == STATUS_OK)
+		{
+			*tempValue = BMP180_CompensateTemperature(bmp180, rawTemp);
+		}
+		else
+		{
+			/* Handle error case */
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_ReadPressure(st_BMP180Handle *bmp180, int32_t *pressureValue)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	float getTemp = 0.0f;
+	int32_t rawPressure = 0;
+
+	/* Check if the pointers are not NULL */
+	if( (bmp180 != NULL) && (pressureValue != NULL) )
+	{
+		/* Read the temperature value if the cached B5 is outdated, then the raw pressure value from the sensor*/
+		if(BMP180_IsTemperatureCacheValid(bmp180) == 0u)
+		{
+			returnValue = BMP180_ReadTemperature(bmp180, &getTemp);
+		}
+		else
+		{
+			returnValue = STATUS_OK;
+		}
+
+		/* The pressure is compensated with B5, not read if the temperature refresh failed */
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = BMP180_GetUncompensatedPressure(bmp180, &rawPressure);
+		}
+
+		/* Check if the read operation was successful */
+		if(returnValue == STATUS_OK)
+		{
+			*pressureValue = BMP180_CompensatePressure(bmp180, rawPressure);
+		}
+		else
+		{
+			/* Handle error case */
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+void BMP180_SetSamplingMode(st_BMP180Handle *bmp180, e_SamplingMode samplingMode)
+{
+	if(bmp180 != NULL)
+	{
+		/* Update the sampling mode in the calibration coefficient structure */
+		bmp180->calibration.samplingMode = samplingMode;
+
+		/* B3 and the B7 factor depend on the sampling mode */
+		BMP180_BuildCompensationTable(bmp180);
+		BMP180_UpdatePressureTerms(bmp180);
+	}
+}
+
+e_SamplingMode BMP180_GetSamplingMode(st_BMP180Handle *bmp180)
+{
+	/* Return the current sampling mode from the calibration coefficient structure */
+	return (bmp180 != NULL) ? bmp180->calibration.samplingMode : ULTRA_LOW_POWER;
+}
+
+void BMP180_InvalidateTemperatureCache(st_BMP180Handle *bmp180)
+{
+	if(bmp180 != NULL)
+	{
+		bmp180->temperatureCache.valid = 0u;
+	}
+}
+
+e_Status BMP180_StartConversion(st_BMP180Handle *bmp180, e_ConversionType conversionType)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(bmp180 == NULL)
+	{
+		/* Handle null pointer */
+		returnValue = STATUS_NOT_OK;
+	}
+	/* Only one conversion can be in progress at a time on each sensor */
+	else if( (bmp180->conversion.state == BMP180_STATE_TEMPERATURE) || (bmp180->conversion.state == BMP180_STATE_PRESSURE) )
+	{
+		returnValue = STATUS_BUSY;
+	}
+	else if( (conversionType == BMP180_CONVERSION_BURST) && ( (bmp180->burst.size == 0u) || (bmp180->burst.size > BMP180_BURST_MAX_SIZE) ) )
+	{
+		/* Burst size is set by BMP180_StartBurst() */
+		returnValue = STATUS_NOT_OK;
+	}
+	else if( (conversionType != BMP180_CONVERSION_TEMPERATURE) && (BMP180_IsTemperatureCacheValid(bmp180) == 1u) )
+	{
+		/* Cached B5 is still valid, go directly to the pressure conversion */
+		bmp180->conversion.type = conversionType;
+		bmp180->burst.count = 0u;
+		bmp180->burst.startTick = COMMON_GET_TICK();
+		bmp180->conversion.temperature = bmp180->temperatureCache.temperature;
+		returnValue = BMP180_StartPressureConversion(bmp180);
+	}
+	else
+	{
+		/* Temperature is converted first, the pressure compensation needs B5 */
+		returnValue = BMP180_StartMeasurement(bmp180, BMP180_TEMPERATURE_START, BMP180_WAIT_TIME);
+
+		if(returnValue == STATUS_OK)
+		{
+			bmp180->conversion.type = conversionType;
+			bmp180->burst.count = 0u;
+			bmp180->burst.startTick = COMMON_GET_TICK();
+			bmp180->conversion.state = BMP180_STATE_TEMPERATURE;
+		}
+		else
+		{
+			bmp180->conversion.state = BMP180_STATE_ERROR;
+		}
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_Poll(st_BMP180Handle *bmp180)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	int32_t rawTemp = 0;
+	int32_t rawPressure = 0;
+
+	/* A NULL context is handled like a context without conversion */
+	e_ConversionState conversionState = (bmp180 != NULL) ? bmp180->conversion.state : BMP180_STATE_IDLE;
+
+	switch(conversionState)
+	{
+		case BMP180_STATE_TEMPERATURE:
+			returnValue = STATUS_BUSY;
+
+			if(BMP180_IsConversionComplete(bmp180) == 1u)
+			{
+				if(BMP180_ReadUncompensatedTemp(bmp180, &rawTemp) == STATUS_OK)
+				{
+					bmp180->conversion.temperature = BMP180_CompensateTemperature(bmp180, rawTemp);
+
+					if(bmp180->conversion.type != BMP180_CONVERSION_TEMPERATURE)
+					{
+						/* Chain the pressure conversion */
+						if(BMP180_StartPressureConversion(bmp180) != STATUS_OK)
+						{
+							returnValue = STATUS_NOT_OK;
+						}
+					}
+					else
+					{
+						bmp180->conversion.state = BMP180_STATE_DONE;
+						returnValue = STATUS_OK;
+					}
+				}
+				else
+				{
+					bmp180->conversion.state = BMP180_STATE_ERROR;
+					returnValue = STATUS_NOT_OK;
+				}
+			}
+			break;
+
+		case BMP180_STATE_PRESSURE:
+			returnValue = STATUS_BUSY;
+
+			if(BMP180_IsConversionComplete(bmp180) == 1u)
+			{
+				if(BMP180_ReadUncompensatedPressure(bmp180, &rawPressure) != STATUS_OK)
+				{
+					bmp180->conversion.state = BMP180_STATE_ERROR;
+					returnValue = STATUS_NOT_OK;
+				}
+				else if(bmp180->conversion.type == BMP180_CONVERSION_BURST)
+				{
+					returnValue = BMP180_ProcessBurstSample(bmp180, rawPressure);
+				}
+				else
+				{
+					bmp180->conversion.pressure = BMP180_CompensatePressure(bmp180, rawPressure);
+					bmp180->conversion.state = BMP180_STATE_DONE;
+					returnValue = STATUS_OK;
+				}
+			}
+			break;
+
+		case BMP180_STATE_DONE:
+			returnValue = STATUS_OK;
+			break;
+
+		default: /* Idle or error, nothing to advance */
+			returnValue = STATUS_NOT_OK;
+			break;
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_GetResult(st_BMP180Handle *bmp180, float *tempValue, int32_t *pressureValue)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if(bmp180 == NULL)
+	{
+		/* Handle null pointer */
+		returnValue = STATUS_NOT_OK;
+	}
+	else if(bmp180->conversion.state == BMP180_STATE_DONE)
+	{
+		if(tempValue != NULL)
+		{
+			*tempValue = bmp180->conversion.temperature;
+		}
+
+		if( (pressureValue != NULL) && (bmp180->conversion.type != BMP180_CONVERSION_TEMPERATURE) )
+		{
+			*pressureValue = bmp180->conversion.pressure;
+		}
+
+		bmp180->conversion.state = BMP180_STATE_IDLE;
+		returnValue = STATUS_OK;
+	}
+	else if( (bmp180->conversion.state == BMP180_STATE_TEMPERATURE) || (bmp180->conversion.state == BMP180_STATE_PRESSURE) )
+	{
+		returnValue = STATUS_BUSY;
+	}
+	else
+	{
+		/* Release the error state so a new conversion can be started */
+		bmp180->conversion.state = BMP180_STATE_IDLE;
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_StartBurst(st_BMP180Handle *bmp180, uint8_t burstSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (burstSize != 0u) && (burstSize <= BMP180_BURST_MAX_SIZE) )
+	{
+		if( (bmp180->conversion.state == BMP180_STATE_TEMPERATURE) || (bmp180->conversion.state == BMP180_STATE_PRESSURE) )
+		{
+			/* Do not change the size of a burst in progress */
+			returnValue = STATUS_BUSY;
+		}
+		else
+		{
+			bmp180->burst.size = burstSize;
+			returnValue = BMP180_StartConversion(bmp180, BMP180_CONVERSION_BURST);
+		}
+	}
+	else
+	{
+		/* Handle null pointer or invalid size */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_SetFilter(st_BMP180Handle *bmp180, e_FilterType filterType, uint8_t parameter)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t maxParameter = (filterType == BMP180_FILTER_IIR) ? BMP180_FILTER_IIR_MAX_SHIFT : BMP180_FILTER_MAX_SIZE;
+
+	if( (bmp180 != NULL) && (parameter != 0u) && (parameter <= maxParameter) )
+	{
+		bmp180->filter.type = filterType;
+		bmp180->filter.parameter = parameter;
+		BMP180_ResetFilter(bmp180);
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid parameter */
+	}
+
+	return returnValue;
+}
+
+void BMP180_ResetFilter(st_BMP180Handle *bmp180)
+{
+	if(bmp180 != NULL)
+	{
+		bmp180->filter.index = 0u;
+		bmp180->filter.count = 0u;
+		bmp180->filter.sum = 0;
+		bmp180->filter.iirState = 0;
+		bmp180->filter.output = 0;
+	}
+}
+
+e_Status BMP180_GetBurstStatistics(st_BMP180Handle *bmp180, st_BurstStatistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (statistics != NULL) )
+	{
+		*statistics = bmp180->burst.statistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_SetSeaLevelPressure(st_BMP180Handle *bmp180, int32_t seaLevelPressure)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (seaLevelPressure > 0) )
+	{
+		/* One division here, BMP180_GetAltitude() only multiplies */
+		bmp180->altitude.seaLevelPressure = seaLevelPressure;
+		bmp180->altitude.seaLevelReciprocal = ((uint64_t)1u << (32u + BMP180_RATIO_SHIFT)) / (uint32_t)seaLevelPressure;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid pressure */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_GetAltitude(st_BMP180Handle *bmp180, int32_t pressureValue, int32_t *altitudeValue)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint32_t pressureRatio = 0u;
+
+	if( (bmp180 != NULL) && (altitudeValue != NULL) && (pressureValue > 0) )
+	{
+		/* p / p0 in Q20 */
+		pressureRatio = (uint32_t)( ((uint64_t)(uint32_t)pressureValue * bmp180->altitude.seaLevelReciprocal) >> 32u );
+
+		/* Clamp to the range of the table */
+		if(pressureRatio < BMP180_RATIO_MIN)
+		{
+			pressureRatio = BMP180_RATIO_MIN;
+		}
+		else if(pressureRatio >= (BMP180_RATIO_MIN + POWER_OF_2(BMP180_TABLE_SPAN_SHIFT)))
+		{
+			pressureRatio = BMP180_RATIO_MIN + POWER_OF_2(BMP180_TABLE_SPAN_SHIFT) - 1u;
+		}
+
+		*altitudeValue = BMP180_InterpolateTable(altitudeTable, pressureRatio - BMP180_RATIO_MIN);
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid pressure */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_GetSeaLevelPressure(int32_t pressureValue, int32_t altitudeValue, int32_t *seaLevelPressure)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	int32_t altitudePosition = altitudeValue - BMP180_ALTITUDE_MIN;
+	int32_t seaLevelFactor = 0;
+
+	if( (seaLevelPressure != NULL) && (pressureValue > 0) )
+	{
+		/* Clamp to the range of the table */
+		if(altitudePosition < 0)
+		{
+			altitudePosition = 0;
+		}
+		else if(altitudePosition >= POWER_OF_2(BMP180_TABLE_SPAN_SHIFT))
+		{
+			altitudePosition = POWER_OF_2(BMP180_TABLE_SPAN_SHIFT) - 1;
+		}
+
+		/* p0 = p * (1 - h/44330)^-5.255, the factor is in Q16 */
+		seaLevelFactor = BMP180_InterpolateTable(seaLevelFactorTable, (uint32_t)altitudePosition);
+		*seaLevelPressure = (int32_t)( ((int64_t)pressureValue * seaLevelFactor) >> BMP180_SEA_LEVEL_FACTOR_SHIFT );
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid pressure */
+	}
+
+	return returnValue;
+}
+
+e_Status BMP180_SetCompletionMode(st_BMP180Handle *bmp180, e_CompletionMode completionMode)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (completionMode < BMP180_COMPLETION_MODE_COUNT) )
+	{
+		bmp180->completionMode = completionMode;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid mode */
+	}
+
+	return returnValue;
+}
+
+void BMP180_EocCallback(st_BMP180Handle *bmp180)
+{
+	if(bmp180 != NULL)
+	{
+		bmp180->conversion.eocFlag = 1u;
+	}
+}
+
+e_Status BMP180_GetLatencyStatistics(st_BMP180Handle *bmp180, e_CompletionMode completionMode, st_LatencyStatistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (bmp180 != NULL) && (statistics != NULL) && (completionMode < BMP180_COMPLETION_MODE_COUNT) )
+	{
+		*statistics = bmp180->latency[completionMode];
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer or invalid mode */
+	}
+
+	return returnValue;
+}
+
+void BMP180_ResetLatencyStatistics(st_BMP180Handle *bmp180)
+{
+	if(bmp180 != NULL)
+	{
+		for(uint8_t i = 0u; i < BMP180_COMPLETION_MODE_COUNT; i++)
+		{
+			bmp180->latency[i].conversionCount = 0u;
+			bmp180->latency[i].minimum = 0u;
+			bmp180->latency[i].maximum = 0u;
+			bmp180->latency[i].total = 0u;
+		}
+	}
+}
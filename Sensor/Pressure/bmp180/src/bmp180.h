@@ -15,6 +15,7 @@
 /* Macro Definitions ----------------------------------*/
 #define BMP180_READ_ADDRESS				0xEF
 #define BMP180_WRITE_ADDRESS			0xEE
+#define BMP180_READ_BIT					0x01
 
 #define BMP180_SOFT_RESET_REGISTER		0xE0
 #define BMP180_SOFT_RESET_VALUE			0xB6
@@ -23,6 +24,7 @@
 #define BMP180_CALIBRATION_SIZE			22u
 
 #define BMP180_CONTROL_REGISTER			0xF4
+#define BMP180_CONTROL_SCO_BIT			0x20	/* Start of conversion, cleared by the sensor when the conversion is complete */
 #define BMP180_OUT_MSB_REGISTER			0xF6
 #define BMP180_OUT_LSB_REGISTER			0xF7
 #define BMP180_OUT_XLSB_REGISTER		0xF8
@@ -36,6 +38,18 @@
 
 #define BMP180_WAIT_TIME				5u
 
+#define BMP180_BURST_MAX_SIZE			16u		/* Maximum back-to-back pressure conversions per burst */
+#define BMP180_FILTER_MAX_SIZE			16u		/* Maximum window of the moving average and median filter */
+#define BMP180_FILTER_IIR_MAX_SHIFT		8u		/* Smallest IIR coefficient is 1/2^8 */
+#define BMP180_NOISE_SCALE				100u	/* Noise is reported in 0.01 Pa */
+
+#define BMP180_SEA_LEVEL_PRESSURE		101325	/* Standard sea-level pressure in Pa */
+#define BMP180_RATIO_SHIFT				20u		/* Pressure ratio p/p0 is calculated in Q20 */
+#define BMP180_RATIO_MIN				262144u	/* Lowest p/p0 of the altitude table, 0.25 in Q20 */
+#define BMP180_ALTITUDE_MIN				(-100000)	/* Lowest altitude of the sea-level table, -1000 m in cm */
+#define BMP180_TABLE_SPAN_SHIFT			20u		/* Both altitude tables span 2^20 (ratio in Q20, altitude in cm) */
+#define BMP180_SEA_LEVEL_FACTOR_SHIFT	16u		/* Sea-level factor is in Q16 */
+
 /* Enums ----------------------------------------------*/
 typedef enum e_SamplingMode
 {
@@ -45,6 +59,38 @@ typedef enum e_SamplingMode
 	ULTRA_HIGH_RESOLUTION
 }e_SamplingMode;
 
+typedef enum e_ConversionType
+{
+	BMP180_CONVERSION_TEMPERATURE = 0x00,
+	BMP180_CONVERSION_PRESSURE,
+	BMP180_CONVERSION_BURST			/* Back-to-back pressure conversions, started by BMP180_StartBurst() */
+}e_ConversionType;
+
+typedef enum e_ConversionState
+{
+	BMP180_STATE_IDLE = 0x00,
+	BMP180_STATE_TEMPERATURE,		/* Temperature conversion in progress */
+	BMP180_STATE_PRESSURE,			/* Pressure conversion in progress */
+	BMP180_STATE_DONE,				/* Result ready to be collected */
+	BMP180_STATE_ERROR
+}e_ConversionState;
+
+typedef enum e_CompletionMode
+{
+	BMP180_COMPLETION_DELAY = 0x00,	/* Wait the worst-case conversion time of the data sheet */
+	BMP180_COMPLETION_SCO,			/* Poll the SCO bit of the control register, early exit */
+	BMP180_COMPLETION_EOC,			/* EOC pin interrupt reported with BMP180_EocCallback(), early exit */
+	BMP180_COMPLETION_MODE_COUNT
+}e_CompletionMode;
+
+typedef enum e_FilterType
+{
+	BMP180_FILTER_NONE = 0x00,
+	BMP180_FILTER_MOVING_AVERAGE,
+	BMP180_FILTER_IIR,
+	BMP180_FILTER_MEDIAN
+}e_FilterType;
+
 
 /* Structures -----------------------------------------*/
 typedef struct st_CalibrationCoeff
@@ -73,54 +119,313 @@ typedef struct st_CalibrationCoeff
 	e_SamplingMode samplingMode;
 }st_CalibrationCoeff;
 
+/* Terms of the compensation derived from the calibration, calculated once instead of on every sample */
+typedef struct st_CompensationTable
+{
+	/* Calculated from the calibration and sampling mode */
+	int32_t   AC1x4;			/* AC1 * 4 */
+	int32_t   MCx2048;			/* MC * 2^11 */
+	uint32_t  B7Factor;			/* 50000 >> samplingMode */
+
+	/* Calculated on every B5 refresh */
+	uint32_t  B4Reciprocal;		/* (2^32 - 1) / B4, replaces the division by B4 */
+}st_CompensationTable;
+
+typedef struct st_TemperatureCache
+{
+	uint8_t   valid;			/* B5 has been calculated since init */
+	uint16_t  sampleCount;		/* Pressure samples using the current B5 */
+	uint32_t  refreshTick;		/* Tick of the last B5 refresh */
+	float     temperature;		/* Temperature matching the current B5 */
+}st_TemperatureCache;
+
+typedef struct st_Conversion
+{
+	e_ConversionType  type;
+	e_ConversionState state;
+
+	/* Timing of the conversion in progress */
+	uint32_t  startTick;
+	uint32_t  waitTime;				/* Worst-case conversion time, upper bound of every completion mode */
+	volatile uint8_t eocFlag;		/* Set from the EOC pin interrupt */
+
+	/* Results of the last conversion */
+	float     temperature;
+	int32_t   pressure;
+}st_Conversion;
+
+/* Running filter fed by the burst pressure samples */
+typedef struct st_PressureFilter
+{
+	e_FilterType type;
+	uint8_t   parameter;		/* Window size (moving average, median) or IIR shift */
+	uint8_t   index;			/* Next slot of the window */
+	uint8_t   count;			/* Samples in the window */
+	int32_t   window[BMP180_FILTER_MAX_SIZE];
+	int32_t   sum;				/* Running sum of the moving average window */
+	int32_t   iirState;			/* IIR output scaled by 2^parameter */
+	int32_t   output;			/* Last filtered pressure in Pa */
+}st_PressureFilter;
+
+/* Statistics of the last completed burst */
+typedef struct st_BurstStatistics
+{
+	uint8_t   sampleCount;
+	uint32_t  elapsedTime;		/* From burst start to last sample (in ms) */
+	uint32_t  samplesPerSecond;	/* Effective pressure samples per second */
+	int32_t   mean;				/* Mean pressure of the batch in Pa */
+	int32_t   minimum;
+	int32_t   maximum;
+	uint32_t  noise;			/* Standard deviation of the batch in 0.01 Pa */
+}st_BurstStatistics;
+
+typedef struct st_Burst
+{
+	uint8_t   size;				/* Conversions per burst */
+	uint8_t   count;			/* Conversions done in the current burst */
+	uint32_t  startTick;
+	int32_t   samples[BMP180_BURST_MAX_SIZE];	/* Raw pressure, compensated in place when the burst completes */
+	st_BurstStatistics statistics;
+}st_Burst;
+
+/* Conversion latency, from the start command to the detected completion (in ms) */
+typedef struct st_LatencyStatistics
+{
+	uint32_t  conversionCount;
+	uint32_t  minimum;
+	uint32_t  maximum;
+	uint32_t  total;				/* Average is total / conversionCount */
+}st_LatencyStatistics;
+
+typedef struct st_Altitude
+{
+	int32_t   seaLevelPressure;		/* Reference pressure p0 in Pa */
+	uint64_t  seaLevelReciprocal;	/* 2^52 / p0, gives p/p0 in Q20 with a multiplication */
+}st_Altitude;
+
+/* Context of one BMP180 sensor. One context per sensor, passed to every BMP180_* function */
+typedef struct st_BMP180Handle
+{
+	/* Bus of the sensor */
+	I2C_HandleTypeDef   *i2cHandle;
+	uint8_t              deviceAddress;		/* 8-bit write address, e.g. BMP180_WRITE_ADDRESS */
+
+	e_CompletionMode     completionMode;
+
+	st_CalibrationCoeff  calibration;
+	st_CompensationTable compensation;
+	st_TemperatureCache  temperatureCache;
+	st_Conversion        conversion;
+	st_Burst             burst;
+	st_PressureFilter    filter;
+	st_Altitude          altitude;
+	st_LatencyStatistics latency[BMP180_COMPLETION_MODE_COUNT];	/* One per completion mode */
+}st_BMP180Handle;
+
 /* Function Declaration -------------------------------*/
 /*
  * @brief  Initializes the BMP180 sensor.
- * @note   Performs a soft reset, checks device readiness, reads calibration coefficients, and sets the sampling mode.
- * @param  None
+ * @note   Binds the context to the bus, performs a soft reset, checks device readiness, reads calibration
+ *         coefficients, and sets the sampling mode.
+ * @param  bmp180         Context of the sensor, owned by the application.
+ * @param  i2cHandle      I2C bus the sensor is connected to.
+ * @param  deviceAddress  8-bit write address of the sensor (BMP180_WRITE_ADDRESS).
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_Init();
+e_Status BMP180_Init(st_BMP180Handle *bmp180, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress);
 
 /*
  * @brief  Deinitializes the BMP180 sensor.
  * @note   Performs a soft reset of the sensor.
- * @param  None
+ * @param  bmp180  Context of the sensor.
  * @retval None
  */
-void BMP180_DeInit();
+void BMP180_DeInit(st_BMP180Handle *bmp180);
 
 /*
  * @brief  Reads the temperature value from the BMP180 sensor.
  * @note   Calculates the actual temperature in Celsius using the uncompensated temperature value.
+ * @param  bmp180     Context of the sensor.
  * @param  tempValue  Pointer to store the calculated temperature value.
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_ReadTemperature(float *tempValue);
+e_Status BMP180_ReadTemperature(st_BMP180Handle *bmp180, float *tempValue);
 
 /*
  * @brief  Reads the pressure value from the BMP180 sensor.
  * @note   Calculates the actual pressure in Pa using the uncompensated pressure value and temperature.
+ * @param  bmp180         Context of the sensor.
  * @param  pressureValue  Pointer to store the calculated pressure value.
  * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_ReadPressure(int32_t *pressureValue);
+e_Status BMP180_ReadPressure(st_BMP180Handle *bmp180, int32_t *pressureValue);
 
 /*
  * @brief  Sets the sampling mode for the BMP180 sensor.
- * @note   Updates the sampling mode in the calibration coefficient structure.
+ * @note   Updates the sampling mode in the calibration coefficient structure and the compensation
+ *         terms depending on it.
+ * @param  bmp180        Context of the sensor.
  * @param  samplingMode  The desired sampling mode for the sensor.
  * @retval None
  */
-void BMP180_SetSamplingMode(e_SamplingMode samplingMode);
+void BMP180_SetSamplingMode(st_BMP180Handle *bmp180, e_SamplingMode samplingMode);
 
 /*
  * @brief  Gets the current sampling mode of the BMP180 sensor.
  * @note   Returns the sampling mode from the calibration coefficient structure.
- * @param  None
+ * @param  bmp180  Context of the sensor.
  * @retval e_SamplingMode  The current sampling mode of the sensor.
  */
-e_SamplingMode BMP180_GetSamplingMode();
+e_SamplingMode BMP180_GetSamplingMode(st_BMP180Handle *bmp180);
+
+/*
+ * @brief  Forces a temperature conversion on the next pressure reading.
+ * @note   The temperature (B5) is otherwise reused as configured in bmp180_cfg.h.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+void BMP180_InvalidateTemperatureCache(st_BMP180Handle *bmp180);
+
+/*
+ * @brief  Starts a non-blocking conversion on the BMP180 sensor.
+ * @note   A pressure conversion first converts the temperature when the cached B5 is outdated,
+ *         as the compensation needs B5.
+ *         The function returns right after the start command is written; use BMP180_Poll() to
+ *         advance the conversion and BMP180_GetResult() to collect it. Each context has its own
+ *         conversion, so conversions on several sensors can be in progress at the same time.
+ * @param  bmp180          Context of the sensor.
+ * @param  conversionType  BMP180_CONVERSION_TEMPERATURE or BMP180_CONVERSION_PRESSURE.
+ * @retval e_Status  STATUS_OK if started, STATUS_BUSY if a conversion is already in progress,
+ *                   STATUS_NOT_OK otherwise.
+ */
+e_Status BMP180_StartConversion(st_BMP180Handle *bmp180, e_ConversionType conversionType);
+
+/*
+ * @brief  Advances the conversion started by BMP180_StartConversion().
+ * @note   Must be called periodically from the main loop. It never waits; the conversion time is
+ *         checked against COMMON_GET_TICK().
+ * @param  bmp180  Context of the sensor.
+ * @retval e_Status  STATUS_BUSY while converting, STATUS_OK once the result is ready,
+ *                   STATUS_NOT_OK if no conversion is started or a bus error occurred.
+ */
+e_Status BMP180_Poll(st_BMP180Handle *bmp180);
+
+/*
+ * @brief  Collects the result of a finished conversion.
+ * @note   Releases the conversion so a new one can be started. The pressure is only valid for
+ *         BMP180_CONVERSION_PRESSURE and BMP180_CONVERSION_BURST. For a burst, it is the filter output.
+ * @param  bmp180         Context of the sensor.
+ * @param  tempValue      Pointer to store the temperature in Celsius (can be NULL).
+ * @param  pressureValue  Pointer to store the pressure in Pa (can be NULL).
+ * @retval e_Status  STATUS_OK if a result was available, STATUS_BUSY if still converting,
+ *                   STATUS_NOT_OK otherwise.
+ */
+e_Status BMP180_GetResult(st_BMP180Handle *bmp180, float *tempValue, int32_t *pressureValue);
+
+/*
+ * @brief  Starts a burst of back-to-back pressure conversions.
+ * @note   One temperature (B5) is used for the whole burst. The conversions are chained in
+ *         BMP180_Poll() without involving the application; once the last one is read, the batch
+ *         is compensated in one pass and fed to the filter. Collect with BMP180_GetResult().
+ * @param  bmp180     Context of the sensor.
+ * @param  burstSize  Number of pressure conversions (1 - BMP180_BURST_MAX_SIZE).
+ * @retval e_Status  STATUS_OK if started, STATUS_BUSY if a conversion is already in progress,
+ *                   STATUS_NOT_OK otherwise.
+ */
+e_Status BMP180_StartBurst(st_BMP180Handle *bmp180, uint8_t burstSize);
+
+/*
+ * @brief  Configures the running filter applied to the burst samples.
+ * @note   Clears the filter history.
+ * @param  bmp180     Context of the sensor.
+ * @param  filterType Filter to apply.
+ * @param  parameter  Window size (1 - BMP180_FILTER_MAX_SIZE) for moving average and median,
+ *                    shift (1 - BMP180_FILTER_IIR_MAX_SHIFT) for IIR, i.e. coefficient 1/2^parameter.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_SetFilter(st_BMP180Handle *bmp180, e_FilterType filterType, uint8_t parameter);
+
+/*
+ * @brief  Clears the history of the running filter.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+void BMP180_ResetFilter(st_BMP180Handle *bmp180);
+
+/*
+ * @brief  Gets the statistics of the last completed burst.
+ * @note   Reports the effective sample rate and the noise of the batch.
+ * @param  bmp180      Context of the sensor.
+ * @param  statistics  Pointer to store the statistics.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_GetBurstStatistics(st_BMP180Handle *bmp180, st_BurstStatistics *statistics);
+
+/*
+ * @brief  Sets the sea-level pressure used by BMP180_GetAltitude().
+ * @note   Defaults to BMP180_SEA_LEVEL_PRESSURE after BMP180_Init().
+ * @param  bmp180            Context of the sensor.
+ * @param  seaLevelPressure  Sea-level pressure in Pa.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_SetSeaLevelPressure(st_BMP180Handle *bmp180, int32_t seaLevelPressure);
+
+/*
+ * @brief  Calculates the altitude from the pressure.
+ * @note   Barometric formula from a lookup table with linear interpolation, no floating point.
+ *         p/p0 is clamped to 0.25 - 1.25. The accuracy is selected with BMP180_ALTITUDE_ACCURACY.
+ * @param  bmp180         Context of the sensor, holds the sea-level pressure.
+ * @param  pressureValue  Pressure in Pa.
+ * @param  altitudeValue  Pointer to store the altitude in cm.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_GetAltitude(st_BMP180Handle *bmp180, int32_t pressureValue, int32_t *altitudeValue);
+
+/*
+ * @brief  Calculates the sea-level pressure from the pressure at a known altitude.
+ * @note   Lookup table with linear interpolation, no floating point. The altitude is clamped to
+ *         -1000 m - 9485 m. The result can be passed to BMP180_SetSeaLevelPressure().
+ * @param  pressureValue     Pressure in Pa.
+ * @param  altitudeValue     Altitude in cm.
+ * @param  seaLevelPressure  Pointer to store the sea-level pressure in Pa.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_GetSeaLevelPressure(int32_t pressureValue, int32_t altitudeValue, int32_t *seaLevelPressure);
+
+/*
+ * @brief  Selects how the end of a conversion is detected.
+ * @note   BMP180_COMPLETION_SCO and BMP180_COMPLETION_EOC finish as soon as the sensor is done and
+ *         fall back to the worst-case conversion time if no completion is seen.
+ * @param  bmp180          Context of the sensor.
+ * @param  completionMode  Completion detection of the sensor.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_SetCompletionMode(st_BMP180Handle *bmp180, e_CompletionMode completionMode);
+
+/*
+ * @brief  Reports the end of conversion of the sensor.
+ * @note   To be called from the EOC pin interrupt (e.g. HAL_GPIO_EXTI_Callback(), rising edge)
+ *         when the completion mode is BMP180_COMPLETION_EOC.
+ * @param  bmp180  Context of the sensor connected to the EOC pin.
+ * @retval None
+ */
+void BMP180_EocCallback(st_BMP180Handle *bmp180);
+
+/*
+ * @brief  Gets the conversion latency statistics of a completion mode.
+ * @param  bmp180          Context of the sensor.
+ * @param  completionMode  Completion mode of the statistics.
+ * @param  statistics      Pointer to store the statistics.
+ * @retval e_Status  Status of the operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status BMP180_GetLatencyStatistics(st_BMP180Handle *bmp180, e_CompletionMode completionMode, st_LatencyStatistics *statistics);
+
+/*
+ * @brief  Clears the conversion latency statistics of all completion modes.
+ * @param  bmp180  Context of the sensor.
+ * @retval None
+ */
+void BMP180_ResetLatencyStatistics(st_BMP180Handle *bmp180);
 
 
 #endif /* BMP180_H_ */
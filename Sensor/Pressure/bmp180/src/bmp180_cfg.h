@@ -13,47 +13,63 @@
 #include "i2c.h"
 
 /* Macro Definition -----------------------------------*/
-#define BMP180_I2C_HANDLER			&hi2c1
 #define BMP180_TIMEOUT				100u
 #define BMP180_TRIAL				3u
 #define BMP180_MEMORY_REG_SIZE		I2C_MEMADD_SIZE_8BIT		/* If the memory register size is 8 bits(0x01) or 16 bits */
 
+/* Reuse of the temperature (B5) between pressure readings. Temperature drifts slowly, so it does not
+ * need to be converted before every pressure sample. B5 is refreshed when either limit is reached.
+ * Set BMP180_TEMP_REFRESH_SAMPLES to 1u to convert the temperature before every pressure sample. */
+#define BMP180_TEMP_REFRESH_SAMPLES	10u		/* Refresh B5 every N pressure samples */
+#define BMP180_TEMP_REFRESH_AGE		1000u	/* Refresh B5 when older than this (in ms). 0u disables the age limit */
+
+/* Accuracy of the altitude and sea-level pressure lookup tables. Worst case altitude error over
+ * p/p0 = 0.25 - 1.25, and in brackets over p/p0 = 0.6 - 1.25 */
+#define BMP180_ACCURACY_LOW			0x00	/* 65 entries per table,  2.4 m (0.52 m) */
+#define BMP180_ACCURACY_MEDIUM		0x01	/* 129 entries per table, 0.62 m (0.13 m) */
+#define BMP180_ACCURACY_HIGH		0x02	/* 257 entries per table, 0.16 m (0.03 m) */
+
+#define BMP180_ALTITUDE_ACCURACY	BMP180_ACCURACY_MEDIUM
+
 
 /* Function Definition --------------------------------*/
 /*
  * @brief  Checks if the BMP180 device is ready.
+ * @param  i2cHandle   I2C bus of the BMP180 device.
  * @param  deviceAddr  Address of the BMP180 device.
  * @retval e_Status  Status of the device readiness (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_IsDeviceReady(uint8_t deviceAddr)
+e_Status BMP180_IsDeviceReady(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr)
 {
-    return (HAL_I2C_IsDeviceReady(BMP180_I2C_HANDLER, deviceAddr, BMP180_TRIAL, BMP180_TIMEOUT));
+    return (HAL_I2C_IsDeviceReady(i2cHandle, deviceAddr, BMP180_TRIAL, BMP180_TIMEOUT));
 }
 
 /*
  * @brief  Writes data to a specific memory address of the BMP180 sensor.
+ * @param  i2cHandle         I2C bus of the BMP180 device.
  * @param  deviceAddr        Address of the BMP180 device.
  * @param  memoryAddr        Memory address to write data.
  * @param  writeDataBuffer   Pointer to the data buffer to be written.
  * @param  writeDataSize     Size of the data to be written.
  * @retval e_Status  Status of the write operation (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_MemoryWrite(uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *writeDataBuffer, uint8_t writeDataSize)
+e_Status BMP180_MemoryWrite(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *writeDataBuffer, uint8_t writeDataSize)
 {
-    return HAL_I2C_Mem_Write(BMP180_I2C_HANDLER, deviceAddr, memoryAddr, BMP180_MEMORY_REG_SIZE, writeDataBuffer, (uint16_t)writeDataSize, BMP180_TIMEOUT);
+    return HAL_I2C_Mem_Write(i2cHandle, deviceAddr, memoryAddr, BMP180_MEMORY_REG_SIZE, writeDataBuffer, (uint16_t)writeDataSize, BMP180_TIMEOUT);
 }
 
 /*
  * @brief  Reads data from a specific memory address of the BMP180 sensor.
+ * @param  i2cHandle        I2C bus of the BMP180 device.
  * @param  deviceAddr       Address of the BMP180 device.
  * @param  memoryAddr       Memory address to read data from.
  * @param  readDataBuffer   Pointer to the data buffer to store the read data.
  * @param  readDataSize     Size of the data to be read.
  * @retval e_Status  Status of the read operation (STATUS_OK or STATUS_NOT_OK).
  */
-e_Status BMP180_MemoryRead(uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *readDataBuffer, uint8_t readDataSize)
+e_Status BMP180_MemoryRead(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *readDataBuffer, uint8_t readDataSize)
 {
-    return HAL_I2C_Mem_Read(BMP180_I2C_HANDLER, deviceAddr, memoryAddr, BMP180_MEMORY_REG_SIZE, readDataBuffer, (uint16_t)readDataSize, BMP180_TIMEOUT);
+    return HAL_I2C_Mem_Read(i2cHandle, deviceAddr, memoryAddr, BMP180_MEMORY_REG_SIZE, readDataBuffer, (uint16_t)readDataSize, BMP180_TIMEOUT);
 }
 
 
@@ -0,0 +1,482 @@
+/**
+ * @file bmp180_sim.c
+ * @brief Host simulator of the BMP180 driver on a model of the sensor
+ *
+ * The model has the calibration registers, the control register with the SCO bit, the output
+ * registers and the EOC pin. A conversion ends before the maximum conversion time of the data
+ * sheet, the bus runs at 400 kHz. The checks drive the start/poll/collect state machine with the
+ * simulated clock, then compare the compensation with the data sheet example and with a reference
+ * of the data sheet algorithm in 64 bits over random calibrations.
+ *
+ * Build and run from the root of the repository:
+ *   gcc -std=c99 -Wall -I Misc -I Sensor/Pressure/bmp180/test/stub -I Sensor/Pressure/bmp180/src
+ *       Sensor/Pressure/bmp180/test/bmp180_sim.c Sensor/Pressure/bmp180/src/bmp180.c
+ *       -o bmp180_sim && ./bmp180_sim
+ *
+ * The exit code is 0 when all the checks pass.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <bmp180.h>
+
+/* Macro Definition -----------------------------------*/
+#define SIM_BYTE_TIME_US			22.5		/* 400 kHz, 9 bits per byte with the acknowledge */
+#define SIM_TEMP_TIME_US			3000.0		/* Conversion times of the model, below the data sheet maximum */
+#define SIM_LOOP_WORK_US			200.0		/* Work of the main loop between two polls */
+#define SIM_CALIBRATION_COUNT		500000L		/* Random calibrations of the compensation check */
+#define SIM_SAMPLES_PER_CALIBRATION	5u
+
+/* Structures -----------------------------------------*/
+
+/* Registers and conversion of the BMP180 */
+typedef struct
+{
+	uint8_t   calibration[BMP180_CALIBRATION_SIZE];
+	uint8_t   control;
+	uint8_t   out[3u];
+	uint16_t  UT;					/* Raw temperature of the next conversion */
+	uint32_t  UP;					/* Raw pressure of the next conversion, 16 to 19 bits */
+	double    conversionEnd;
+	uint8_t   converting;
+	uint8_t   failRead;				/* The next read of the output is not acknowledged */
+	uint32_t  transferCount;
+}st_SimSensor;
+
+/* Calibration coefficients, in the order of the registers */
+typedef struct
+{
+	int16_t   AC1;
+	int16_t   AC2;
+	int16_t   AC3;
+	uint16_t  AC4;
+	uint16_t  AC5;
+	uint16_t  AC6;
+	int16_t   B1;
+	int16_t   B2;
+	int16_t   MB;
+	int16_t   MC;
+	int16_t   MD;
+}st_SimCalibration;
+
+/* Result of the reference compensation */
+typedef struct
+{
+	int32_t   B5;
+	int64_t   B3;
+	uint64_t  B4;
+	int32_t   p;
+}st_SimReference;
+
+/* Variables ------------------------------------------*/
+I2C_HandleTypeDef hi2c1;
+
+static double simTime = 0.0;				/* in us */
+static double tickCost = 1.0;				/* Time of one HAL_GetTick() call, raised for the long runs */
+static st_SimSensor sensor;
+static st_BMP180Handle bmp180;
+
+static const double pressureTime[ULTRA_HIGH_RESOLUTION + 1u] = {3000.0, 5000.0, 9000.0, 17000.0};
+static const st_SimCalibration datasheetCalibration = {408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868};
+
+/* Static Function Declaration ------------------------*/
+static void SIM_Bus(uint32_t byteCount);
+static void SIM_Interrupt(void);
+static void SIM_SetCalibration(const st_SimCalibration *calibration);
+static uint8_t SIM_Reference(const st_SimCalibration *cal, int32_t UT, int32_t UP, uint8_t oss, st_SimReference *result);
+static int SIM_StateMachine(void);
+static int SIM_Compensation(void);
+
+/* HAL model ------------------------------------------*/
+
+void HAL_Delay(uint32_t Delay)
+{
+	simTime += Delay * 1000.0;
+	SIM_Interrupt();
+}
+
+uint32_t HAL_GetTick(void)
+{
+	/* Spinning on the tick costs time */
+	simTime += tickCost;
+	SIM_Interrupt();
+
+	return (uint32_t)(simTime / 1000.0);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+	(void)hi2c; (void)Trials; (void)Timeout;
+	SIM_Bus(1u);
+
+	return ((DevAddress & ~BMP180_READ_BIT) == BMP180_WRITE_ADDRESS) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+	uint8_t oss = 0u;
+
+	(void)hi2c; (void)MemAddSize; (void)Timeout;
+	SIM_Bus(2u + Size);
+
+	if( (DevAddress == BMP180_WRITE_ADDRESS) && (Size == 1u) )
+	{
+		returnValue = HAL_OK;
+		if(MemAddress == BMP180_CONTROL_REGISTER)
+		{
+			/* The conversion starts at the stop condition */
+			sensor.control = pData[0];
+			sensor.converting = 1u;
+			if(pData[0] == BMP180_TEMPERATURE_START)
+			{
+				sensor.conversionEnd = simTime + SIM_TEMP_TIME_US;
+			}
+			else
+			{
+				oss = pData[0] >> 6u;
+				sensor.conversionEnd = simTime + pressureTime[oss];
+			}
+		}
+		else if( (MemAddress == BMP180_SOFT_RESET_REGISTER) && (pData[0] == BMP180_SOFT_RESET_VALUE) )
+		{
+			sensor.control = 0u;
+			sensor.converting = 0u;
+		}
+		else
+		{
+			returnValue = HAL_ERROR;
+		}
+	}
+
+	sensor.transferCount++;
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+
+	(void)hi2c; (void)MemAddSize; (void)Timeout;
+	SIM_Bus(3u + Size);
+	SIM_Interrupt();
+
+	if(DevAddress != (BMP180_WRITE_ADDRESS | BMP180_READ_BIT))
+	{
+		/* Not acknowledged */
+	}
+	else if( (MemAddress >= BMP180_CALIBRATION_REGISTER) && ((MemAddress + Size) <= (BMP180_CALIBRATION_REGISTER + BMP180_CALIBRATION_SIZE)) )
+	{
+		memcpy(pData, &sensor.calibration[MemAddress - BMP180_CALIBRATION_REGISTER], Size);
+		returnValue = HAL_OK;
+	}
+	else if( (MemAddress == BMP180_CONTROL_REGISTER) && (Size == 1u) )
+	{
+		pData[0] = sensor.control;
+		returnValue = HAL_OK;
+	}
+	else if( (MemAddress >= BMP180_OUT_MSB_REGISTER) && ((MemAddress + Size) <= (BMP180_OUT_XLSB_REGISTER + 1u)) && (sensor.failRead == 0u) )
+	{
+		memcpy(pData, &sensor.out[MemAddress - BMP180_OUT_MSB_REGISTER], Size);
+		returnValue = HAL_OK;
+	}
+	else
+	{
+		sensor.failRead = 0u;
+	}
+
+	sensor.transferCount++;
+
+	return returnValue;
+}
+
+/* Static Function Definition -------------------------*/
+
+static void SIM_Bus(uint32_t byteCount)
+{
+	simTime += byteCount * SIM_BYTE_TIME_US;
+}
+
+static void SIM_Interrupt(void)
+{
+	uint32_t rawPressure = 0u;
+	uint8_t oss = 0u;
+
+	/* End of conversion: output registers loaded, SCO cleared, EOC pin high */
+	if( (sensor.converting == 1u) && (simTime >= sensor.conversionEnd) )
+	{
+		sensor.converting = 0u;
+		if(sensor.control == BMP180_TEMPERATURE_START)
+		{
+			sensor.out[0] = (uint8_t)(sensor.UT >> 8u);
+			sensor.out[1] = (uint8_t)sensor.UT;
+		}
+		else
+		{
+			oss = sensor.control >> 6u;
+			rawPressure = sensor.UP << (8u - oss);
+			sensor.out[0] = (uint8_t)(rawPressure >> 16u);
+			sensor.out[1] = (uint8_t)(rawPressure >> 8u);
+			sensor.out[2] = (uint8_t)rawPressure;
+		}
+		sensor.control &= (uint8_t)~BMP180_CONTROL_SCO_BIT;
+
+		if(bmp180.completionMode == BMP180_COMPLETION_EOC)
+		{
+			BMP180_EocCallback(&bmp180);
+		}
+	}
+	else if(sensor.converting == 1u)
+	{
+		sensor.control |= BMP180_CONTROL_SCO_BIT;
+	}
+	else
+	{
+		/* Idle */
+	}
+}
+
+static void SIM_SetCalibration(const st_SimCalibration *calibration)
+{
+	const int16_t *coefficient = &calibration->AC1;
+
+	/* Big endian, in the order of the registers */
+	for(uint8_t index = 0u; index < (BMP180_CALIBRATION_SIZE / 2u); index++)
+	{
+		sensor.calibration[2u * index] = (uint8_t)((uint16_t)coefficient[index] >> 8u);
+		sensor.calibration[(2u * index) + 1u] = (uint8_t)coefficient[index];
+	}
+}
+
+static uint8_t SIM_Reference(const st_SimCalibration *cal, int32_t UT, int32_t UP, uint8_t oss, st_SimReference *result)
+{
+	int64_t X1 = 0;
+	int64_t X2 = 0;
+	int64_t X3 = 0;
+	int64_t B3 = 0;
+	int64_t B6 = 0;
+	int64_t pressure = 0;
+	uint64_t B4 = 0u;
+	uint64_t B7 = 0u;
+	uint8_t inRange = 0u;
+
+	/* Algorithm of the data sheet, divisions by 2^n as arithmetic shifts, every term in 64 bits */
+	X1 = ((int64_t)(UT - cal->AC6) * cal->AC5) >> 15;
+	X2 = (X1 + cal->MD != 0) ? (((int64_t)cal->MC * 2048) / (X1 + cal->MD)) : 0;
+	result->B5 = (int32_t)(X1 + X2);
+
+	B6 = result->B5 - 4000;
+	X1 = (cal->B2 * ((B6 * B6) >> 12)) >> 11;
+	X2 = (cal->AC2 * B6) >> 11;
+	X3 = X1 + X2;
+	B3 = ((((int64_t)cal->AC1 * 4 + X3) << oss) + 2) >> 2;
+	X1 = (cal->AC3 * B6) >> 13;
+	X2 = (cal->B1 * ((B6 * B6) >> 12)) >> 16;
+	X3 = ((X1 + X2) + 2) >> 2;
+	B4 = ((uint64_t)cal->AC4 * (uint64_t)(uint32_t)(X3 + 32768)) >> 15;
+	B7 = ((uint64_t)(uint32_t)(UP - B3) * (50000u >> oss)) & 0xFFFFFFFFu;
+	result->B3 = B3;
+	result->B4 = B4;
+
+	if(B4 != 0u)
+	{
+		pressure = (B7 < 0x80000000u) ? (int64_t)((B7 * 2u) / B4) : (int64_t)((B7 / B4) * 2u);
+		X1 = (pressure >> 8) * (pressure >> 8);
+		X1 = (X1 * 3038) >> 16;
+		X2 = (-7357 * pressure) >> 16;
+		pressure = pressure + ((X1 + X2 + 3791) >> 4);
+		result->p = (int32_t)pressure;
+
+		/* Operating range of the driver: B6 within +/-2^14, 300 to 1100 hPa */
+		inRange = ( (B6 >= -16384) && (B6 <= 16384) && (X3 + 32768 >= 0) && (pressure >= 30000) && (pressure <= 110000) ) ? 1u : 0u;
+	}
+
+	return inRange;
+}
+
+static int SIM_StateMachine(void)
+{
+	int failCount = 0;
+	e_Status status = STATUS_OK;
+	st_LatencyStatistics latency;
+	float temperature = 0.0f;
+	int32_t pressure = 0;
+	uint32_t pollCount = 0u;
+	double callStart = 0.0;
+	double callTime = 0.0;
+	double maxCallTime = 0.0;
+	double startTime = 0.0;
+	static const char *modeName[BMP180_COMPLETION_MODE_COUNT] = {"delay", "SCO", "EOC"};
+
+	printf("State machine: start, poll every %.1f ms, collect\n", SIM_LOOP_WORK_US / 1000.0);
+	memset(&sensor, 0, sizeof(sensor));
+	SIM_SetCalibration(&datasheetCalibration);
+	sensor.UT = 27898u;
+	sensor.UP = 23843u;
+	failCount += (BMP180_Init(&bmp180, &hi2c1, BMP180_WRITE_ADDRESS) != STATUS_OK);
+
+	/* Each mode: a pressure with the temperature first, then pressures with the cached temperature */
+	for(uint8_t mode = 0u; mode < BMP180_COMPLETION_MODE_COUNT; mode++)
+	{
+		failCount += (BMP180_SetCompletionMode(&bmp180, (e_CompletionMode)mode) != STATUS_OK);
+		BMP180_ResetLatencyStatistics(&bmp180);
+		BMP180_InvalidateTemperatureCache(&bmp180);
+		maxCallTime = 0.0;
+
+		for(uint8_t sample = 0u; sample < 5u; sample++)
+		{
+			startTime = simTime;
+			failCount += (BMP180_StartConversion(&bmp180, BMP180_CONVERSION_PRESSURE) != STATUS_OK);
+			failCount += (BMP180_StartConversion(&bmp180, BMP180_CONVERSION_TEMPERATURE) != STATUS_BUSY);
+			failCount += (BMP180_GetResult(&bmp180, &temperature, &pressure) != STATUS_BUSY);
+
+			do
+			{
+				simTime += SIM_LOOP_WORK_US;
+				callStart = simTime;
+				status = BMP180_Poll(&bmp180);
+				callTime = simTime - callStart;
+				maxCallTime = (callTime > maxCallTime) ? callTime : maxCallTime;
+				pollCount++;
+			}while(status == STATUS_BUSY);
+
+			failCount += (status != STATUS_OK);
+			failCount += (BMP180_GetResult(&bmp180, &temperature, &pressure) != STATUS_OK);
+			failCount += (temperature != 15.0f) + (pressure != 69964);
+			if(sample == 0u)
+			{
+				printf("  %-5s: temperature and pressure after %.1f ms,", modeName[mode], (simTime - startTime) / 1000.0);
+			}
+		}
+
+		BMP180_GetLatencyStatistics(&bmp180, (e_CompletionMode)mode, &latency);
+		printf(" conversion latency %u to %u ms, longest call %.0f us\n", latency.minimum, latency.maximum, maxCallTime);
+		failCount += (latency.conversionCount != 6u) + (maxCallTime > 500.0);
+	}
+
+	/* A bus error ends the conversion, the next one starts again */
+	BMP180_InvalidateTemperatureCache(&bmp180);
+	failCount += (BMP180_StartConversion(&bmp180, BMP180_CONVERSION_TEMPERATURE) != STATUS_OK);
+	sensor.failRead = 1u;
+	do
+	{
+		simTime += SIM_LOOP_WORK_US;
+		status = BMP180_Poll(&bmp180);
+	}while(status == STATUS_BUSY);
+
+	failCount += (status != STATUS_NOT_OK);
+	failCount += (BMP180_GetResult(&bmp180, &temperature, &pressure) != STATUS_NOT_OK);
+	failCount += (BMP180_StartConversion(&bmp180, BMP180_CONVERSION_TEMPERATURE) != STATUS_OK);
+	do
+	{
+		simTime += SIM_LOOP_WORK_US;
+		status = BMP180_Poll(&bmp180);
+	}while(status == STATUS_BUSY);
+
+	failCount += (status != STATUS_OK) + (BMP180_GetResult(&bmp180, &temperature, NULL) != STATUS_OK) + (temperature != 15.0f);
+	printf("  %u polls, bus error recovered: %s\n", pollCount, (failCount == 0) ? "yes" : "no");
+
+	return failCount;
+}
+
+static int SIM_Compensation(void)
+{
+	int failCount = 0;
+	st_SimCalibration calibration;
+	float temperature = 0.0f;
+	int32_t pressure = 0;
+	st_SimReference reference;
+	int32_t target = 0;
+	int64_t UP = 0;
+	uint8_t oss = 0u;
+	uint32_t UPMax = 0u;
+	uint32_t checkCount = 0u;
+	uint32_t skipCount = 0u;
+	uint32_t badCount = 0u;
+
+	printf("Compensation: data sheet example, then %ld random calibrations of %u samples\n", SIM_CALIBRATION_COUNT, SIM_SAMPLES_PER_CALIBRATION);
+	memset(&sensor, 0, sizeof(sensor));
+	tickCost = 100.0;
+
+	/* Example of the data sheet: 15.0 C and 69964 Pa */
+	SIM_SetCalibration(&datasheetCalibration);
+	sensor.UT = 27898u;
+	sensor.UP = 23843u;
+	failCount += (BMP180_Init(&bmp180, &hi2c1, BMP180_WRITE_ADDRESS) != STATUS_OK);
+	failCount += (BMP180_ReadTemperature(&bmp180, &temperature) != STATUS_OK);
+	failCount += (BMP180_ReadPressure(&bmp180, &pressure) != STATUS_OK);
+	printf("  data sheet example: %.1f C, %ld Pa\n", (double)temperature, (long)pressure);
+	failCount += (temperature != 15.0f) + (pressure != 69964);
+
+	for(long set = 0L; set < SIM_CALIBRATION_COUNT; set++)
+	{
+		/* Spread over the data sheet example and the parts in the field */
+		calibration.AC1 = (int16_t)(300 + (rand() % 9700));
+		calibration.AC2 = (int16_t)(-1500 + (rand() % 1500));
+		calibration.AC3 = (int16_t)(-15000 + (rand() % 2000));
+		calibration.AC4 = (uint16_t)(30000 + (rand() % 5000));
+		calibration.AC5 = (uint16_t)(20000 + (rand() % 13000));
+		calibration.AC6 = (uint16_t)(12000 + (rand() % 12000));
+		calibration.B1 = (int16_t)(5500 + (rand() % 1500));
+		calibration.B2 = (int16_t)(rand() % 60);
+		calibration.MB = -32768;
+		calibration.MC = (int16_t)(-12000 + (rand() % 4000));
+		calibration.MD = (int16_t)(2000 + (rand() % 1000));
+		SIM_SetCalibration(&calibration);
+		failCount += (BMP180_Init(&bmp180, &hi2c1, BMP180_WRITE_ADDRESS) != STATUS_OK);
+
+		for(uint8_t sample = 0u; sample < SIM_SAMPLES_PER_CALIBRATION; sample++)
+		{
+			oss = (uint8_t)(rand() % (ULTRA_HIGH_RESOLUTION + 1u));
+			UPMax = (1u << (16u + oss)) - 1u;
+			sensor.UT = (uint16_t)(calibration.AC6 - 6000 + (rand() % 20000));
+
+			/* Raw pressure of a random pressure of the range, from the inverse of p = 2 * B7 / B4 */
+			(void)SIM_Reference(&calibration, sensor.UT, 0, oss, &reference);
+			target = 30000 + (rand() % 80000);
+			UP = reference.B3 + (((int64_t)target * (int64_t)reference.B4) / (2 * (int64_t)(50000u >> oss)));
+			sensor.UP = (uint32_t)((UP < 0) ? 0 : ((UP > UPMax) ? UPMax : UP));
+
+			if(SIM_Reference(&calibration, sensor.UT, (int32_t)sensor.UP, oss, &reference) == 1u)
+			{
+				BMP180_SetSamplingMode(&bmp180, (e_SamplingMode)oss);
+				BMP180_InvalidateTemperatureCache(&bmp180);
+				failCount += (BMP180_ReadTemperature(&bmp180, &temperature) != STATUS_OK);
+				failCount += (BMP180_ReadPressure(&bmp180, &pressure) != STATUS_OK);
+				badCount += (temperature != (((reference.B5 + 8) >> 4) / 10.0f)) + (pressure != reference.p);
+				checkCount++;
+			}
+			else
+			{
+				skipCount++;
+			}
+		}
+	}
+
+	tickCost = 1.0;
+	printf("  %u samples checked, %u outside the operating range skipped, %u different from the reference\n", checkCount, skipCount, badCount);
+	failCount += (int)badCount + (checkCount < (SIM_CALIBRATION_COUNT * SIM_SAMPLES_PER_CALIBRATION / 2u));
+
+	return failCount;
+}
+
+/* Function Definition --------------------------------*/
+
+int main(void)
+{
+	int failCount = 0;
+
+	srand(7u);
+	failCount += SIM_StateMachine();
+	failCount += SIM_Compensation();
+	printf("%s\n", (failCount == 0) ? "PASS" : "FAIL");
+
+	return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file stm32f0xx_hal.h
+ * @brief Host stand-in of the STM32 HAL for the BMP180 simulator
+ *
+ * Only the declarations used by common.h and the BMP180 driver. The functions
+ * are defined by the simulator.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef STM32F0XX_HAL_H_
+#define STM32F0XX_HAL_H_
+
+/* Includes -------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Macro Definition -----------------------------------*/
+#define I2C_MEMADD_SIZE_8BIT		1u
+#define I2C_MEMADD_SIZE_16BIT		2u
+
+/* Structures -----------------------------------------*/
+typedef struct
+{
+	uint32_t  instance;
+}I2C_HandleTypeDef;
+
+typedef enum
+{
+	HAL_OK = 0x00,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT
+}HAL_StatusTypeDef;
+
+/* Function Declaration -------------------------------*/
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+static inline void __DMB(void) { }
+static inline uint32_t __get_PRIMASK(void) { return 0u; }
+static inline void __disable_irq(void) { }
+static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+
+
+#endif /* STM32F0XX_HAL_H_ */
@@ -0,0 +1,224 @@
+/**
+ * @file at24c256.c
+ * @brief Driver for AT24C256 I2C EEPROM
+ *
+ * This file contains the implementation for AT24C256 EEPROM interfacing functions.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include "at24c256.h"
+#include "at24c256_cfg.h"
+
+/* Variables ------------------------------------------*/
+
+
+/* Static Function Declaration ------------------------*/
+/**
+ * @brief Checks that a range of addresses is within the memory.
+ *
+ * @param[in] memoryAddress First address of the range.
+ * @param[in] size Number of bytes of the range.
+ * @return e_Status STATUS_OK if within the memory and not empty, STATUS_NOT_OK otherwise.
+ */
+static e_Status AT24C256_CheckRange(uint16_t memoryAddress, uint16_t size);
+
+/* Static Function Definition -------------------------*/
+
+static e_Status AT24C256_CheckRange(uint16_t memoryAddress, uint16_t size)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (size != 0u) && (((uint32_t)memoryAddress + size) <= AT24C256_MEMORY_SIZE) )
+	{
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* A sequential access would roll over to the start of the memory */
+	}
+
+	return returnValue;
+}
+
+/* Function Definition --------------------------------*/
+
+e_Status AT24C256_Init(st_AT24C256Handle *eeprom, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (eeprom != NULL) && (i2cHandle != NULL) )
+	{
+		eeprom->i2cHandle = i2cHandle;
+		eeprom->deviceAddress = deviceAddress;
+		AT24C256_ResetStatistics(eeprom);
+
+		/* A write cycle started before a reset of the MCU may still be in progress */
+		eeprom->writePending = 1u;
+		returnValue = AT24C256_WaitReady(eeprom);
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status AT24C256_Write(st_AT24C256Handle *eeprom, uint16_t memoryAddress, const uint8_t *writeData, uint16_t writeSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint16_t pageSize = 0u;
+
+	if( (eeprom != NULL) && (writeData != NULL) )
+	{
+		returnValue = AT24C256_CheckRange(memoryAddress, writeSize);
+
+		while( (writeSize != 0u) && (returnValue == STATUS_OK) )
+		{
+			/* Up to the end of the page, the address counter wraps inside the page */
+			pageSize = AT24C256_PAGE_SIZE - (memoryAddress & AT24C256_PAGE_MASK);
+			if(pageSize > writeSize)
+			{
+				pageSize = writeSize;
+			}
+
+			/* The EEPROM ignores the write until the previous write cycle ends */
+			returnValue = AT24C256_WaitReady(eeprom);
+
+			if(returnValue == STATUS_OK)
+			{
+				returnValue = AT24C256_MemoryWrite(eeprom->i2cHandle, eeprom->deviceAddress, memoryAddress, (uint8_t*)writeData, pageSize);
+
+				/* Even a failed write may have started a write cycle */
+				eeprom->writePending = 1u;
+			}
+
+			if(returnValue == STATUS_OK)
+			{
+				eeprom->statistics.writeCycleCount++;
+				eeprom->statistics.writeByteCount += pageSize;
+				memoryAddress += pageSize;
+				writeData += pageSize;
+				writeSize -= pageSize;
+			}
+			else
+			{
+				/*Error handler*/
+			}
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status AT24C256_Read(st_AT24C256Handle *eeprom, uint16_t memoryAddress, uint8_t *readData, uint16_t readSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (eeprom != NULL) && (readData != NULL) )
+	{
+		returnValue = AT24C256_CheckRange(memoryAddress, readSize);
+
+		/* The EEPROM does not answer during a write cycle */
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = AT24C256_WaitReady(eeprom);
+		}
+
+		/* Random read of the first byte, the EEPROM then increments the address over the whole memory */
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = AT24C256_MemoryRead(eeprom->i2cHandle, eeprom->deviceAddress, memoryAddress, readData, readSize);
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			eeprom->statistics.readCount++;
+			eeprom->statistics.readByteCount += readSize;
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status AT24C256_WaitReady(st_AT24C256Handle *eeprom)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint32_t pollStart = 0u;
+
+	if(eeprom != NULL)
+	{
+		returnValue = STATUS_OK;
+
+		if(eeprom->writePending == 1u)
+		{
+			/* ACK polling: the address is acknowledged again once the write cycle ends */
+			pollStart = COMMON_GET_TICK();
+			returnValue = STATUS_BUSY;
+
+			while(returnValue == STATUS_BUSY)
+			{
+				if(AT24C256_IsDeviceReady(eeprom->i2cHandle, eeprom->deviceAddress) == STATUS_OK)
+				{
+					eeprom->writePending = 0u;
+					returnValue = STATUS_OK;
+				}
+				else if( (uint32_t)(COMMON_GET_TICK() - pollStart) > AT24C256_POLL_TIMEOUT )
+				{
+					returnValue = STATUS_TIMEOUT;
+				}
+				else
+				{
+					eeprom->statistics.pollCount++;
+				}
+			}
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status AT24C256_GetStatistics(st_AT24C256Handle *eeprom, st_AT24C256Statistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (eeprom != NULL) && (statistics != NULL) )
+	{
+		*statistics = eeprom->statistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+void AT24C256_ResetStatistics(st_AT24C256Handle *eeprom)
+{
+	if(eeprom != NULL)
+	{
+		eeprom->statistics.writeCycleCount = 0u;
+		eeprom->statistics.writeByteCount = 0u;
+		eeprom->statistics.pollCount = 0u;
+		eeprom->statistics.readCount = 0u;
+		eeprom->statistics.readByteCount = 0u;
+	}
+}
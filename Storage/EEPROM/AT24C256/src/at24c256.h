@@ -0,0 +1,123 @@
+/**
+ * @file at24c256.h
+ * @brief Driver for AT24C256 I2C EEPROM
+ *
+ * This file contains the declarations for AT24C256 EEPROM interfacing functions.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef AT24C256_H_
+#define AT24C256_H_
+
+/* Includes -------------------------------------------*/
+#include <common.h>
+
+/* Macro Definition -----------------------------------*/
+#define AT24C256_7BIT_I2C_ADDRESS			0x50	/* A2, A1 and A0 low */
+#define AT24C256_I2C_WRITE_ADDRESS			(AT24C256_7BIT_I2C_ADDRESS << 1)
+#define AT24C256_I2C_ADDRESS(a)				( (AT24C256_7BIT_I2C_ADDRESS | ((a) & 0x07)) << 1 )	/* 8-bit write address for the A2-A0 pins */
+
+#define AT24C256_MEMORY_SIZE				32768u	/* in bytes */
+#define AT24C256_PAGE_SIZE					64u		/* A page write wraps inside its page, it must not cross it */
+#define AT24C256_PAGE_MASK					(AT24C256_PAGE_SIZE - 1u)
+
+/* Timing (Refer AT24C256 Data sheet) */
+#define AT24C256_WRITE_CYCLE_TIME			5u		/* in ms, maximum self-timed write cycle (tWR) */
+
+/* Structures -----------------------------------------*/
+
+/* Bus usage of the EEPROM, writeCycleCount is the wear and the main cost of the writes */
+typedef struct st_AT24C256Statistics
+{
+	uint32_t  writeCycleCount;		/* Page writes, each one is a write cycle of the EEPROM */
+	uint32_t  writeByteCount;		/* Bytes written */
+	uint32_t  pollCount;			/* Address polls not acknowledged, a write cycle was in progress */
+	uint32_t  readCount;			/* Sequential reads */
+	uint32_t  readByteCount;		/* Bytes read */
+}st_AT24C256Statistics;
+
+/* Context of one EEPROM */
+typedef struct st_AT24C256Handle
+{
+	/* Bus of the EEPROM */
+	I2C_HandleTypeDef     *i2cHandle;
+	uint8_t                deviceAddress;	/* 8-bit write address, e.g. AT24C256_I2C_WRITE_ADDRESS */
+
+	uint8_t                writePending;	/* 1 while the last write cycle may not be finished */
+	st_AT24C256Statistics  statistics;
+}st_AT24C256Handle;
+
+/* Function Declaration -------------------------------*/
+
+/**
+ * @brief Initializes the AT24C256 EEPROM.
+ *
+ * Binds the context to the bus and checks that the EEPROM acknowledges its address.
+ *
+ * @param[in] eeprom Context of the EEPROM, owned by the application.
+ * @param[in] i2cHandle I2C bus the EEPROM is connected to.
+ * @param[in] deviceAddress 8-bit write address of the EEPROM (AT24C256_I2C_WRITE_ADDRESS).
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status AT24C256_Init(st_AT24C256Handle *eeprom, I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddress);
+
+/**
+ * @brief Writes data of any length at any address.
+ *
+ * The data is split on the page boundaries, one page write (and one write cycle) per page touched.
+ * The end of the previous write cycle is detected by ACK polling before each page write. The
+ * function returns right after the last page write, its write cycle is waited for by the next access.
+ *
+ * @param[in] eeprom Context of the EEPROM.
+ * @param[in] memoryAddress First address to write (0 to AT24C256_MEMORY_SIZE - 1).
+ * @param[in] writeData Pointer to the data to write.
+ * @param[in] writeSize Number of bytes to write, the last one must be within the memory.
+ * @return e_Status STATUS_OK if written, STATUS_TIMEOUT if a write cycle did not end,
+ * 					STATUS_NOT_OK otherwise.
+ */
+e_Status AT24C256_Write(st_AT24C256Handle *eeprom, uint16_t memoryAddress, const uint8_t *writeData, uint16_t writeSize);
+
+/**
+ * @brief Reads data of any length from any address in one sequential read.
+ *
+ * @param[in] eeprom Context of the EEPROM.
+ * @param[in] memoryAddress First address to read (0 to AT24C256_MEMORY_SIZE - 1).
+ * @param[out] readData Pointer to store the data.
+ * @param[in] readSize Number of bytes to read, the last one must be within the memory.
+ * @return e_Status STATUS_OK if read, STATUS_TIMEOUT if the write cycle in progress did not end,
+ * 					STATUS_NOT_OK otherwise.
+ */
+e_Status AT24C256_Read(st_AT24C256Handle *eeprom, uint16_t memoryAddress, uint8_t *readData, uint16_t readSize);
+
+/**
+ * @brief Waits for the end of the write cycle in progress.
+ *
+ * The EEPROM does not acknowledge its address during a write cycle, the address is polled until
+ * it does, up to twice AT24C256_WRITE_CYCLE_TIME.
+ *
+ * @param[in] eeprom Context of the EEPROM.
+ * @return e_Status STATUS_OK if ready, STATUS_TIMEOUT if the write cycle did not end,
+ * 					STATUS_NOT_OK otherwise.
+ */
+e_Status AT24C256_WaitReady(st_AT24C256Handle *eeprom);
+
+/**
+ * @brief Gets the bus usage of the EEPROM.
+ *
+ * @param[in] eeprom Context of the EEPROM.
+ * @param[out] statistics Pointer to store the statistics.
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status AT24C256_GetStatistics(st_AT24C256Handle *eeprom, st_AT24C256Statistics *statistics);
+
+/**
+ * @brief Clears the bus usage of the EEPROM.
+ *
+ * @param[in] eeprom Context of the EEPROM.
+ */
+void AT24C256_ResetStatistics(st_AT24C256Handle *eeprom);
+
+
+#endif /* AT24C256_H_ */
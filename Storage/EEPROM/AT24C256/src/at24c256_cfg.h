@@ -0,0 +1,64 @@
+/**
+ * @file at24c256_cfg.h
+ * @brief Configuration for AT24C256 I2C EEPROM
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef AT24C256_CFG_H_
+#define AT24C256_CFG_H_
+
+/* Includes -------------------------------------------*/
+#include <common.h>
+#include "i2c.h"
+
+/* Macro Definition -----------------------------------*/
+#define AT24C256_TIMEOUT			100u
+#define AT24C256_POLL_TRIAL			1u		/* One address probe per poll, the polling loop is in the driver */
+#define AT24C256_POLL_TIMEOUT		(2u * AT24C256_WRITE_CYCLE_TIME)	/* in ms, end of a write cycle */
+#define AT24C256_MEMORY_REG_SIZE	I2C_MEMADD_SIZE_16BIT		/* If the memory register size is 8 bits(0x01) or 16 bits */
+
+/* Function Definition --------------------------------*/
+/*
+ * @brief  Checks if the AT24C256 device acknowledges its address.
+ * @note   Not acknowledged during a write cycle, used for the ACK polling.
+ * @param  i2cHandle   I2C bus of the AT24C256 device.
+ * @param  deviceAddr  Address of the AT24C256 device.
+ * @retval e_Status  Status of the device readiness (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status AT24C256_IsDeviceReady(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr)
+{
+    return (HAL_I2C_IsDeviceReady(i2cHandle, deviceAddr, AT24C256_POLL_TRIAL, AT24C256_TIMEOUT));
+}
+
+/*
+ * @brief  Writes data to a specific memory address of the AT24C256 (page write).
+ * @param  i2cHandle         I2C bus of the AT24C256 device.
+ * @param  deviceAddr        Address of the AT24C256 device.
+ * @param  memoryAddr        Memory address to write data.
+ * @param  writeDataBuffer   Pointer to the data buffer to be written.
+ * @param  writeDataSize     Size of the data to be written, up to the end of the page.
+ * @retval e_Status  Status of the write operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status AT24C256_MemoryWrite(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *writeDataBuffer, uint16_t writeDataSize)
+{
+    return HAL_I2C_Mem_Write(i2cHandle, deviceAddr, memoryAddr, AT24C256_MEMORY_REG_SIZE, writeDataBuffer, writeDataSize, AT24C256_TIMEOUT);
+}
+
+/*
+ * @brief  Reads data from a specific memory address of the AT24C256 (sequential read).
+ * @param  i2cHandle        I2C bus of the AT24C256 device.
+ * @param  deviceAddr       Address of the AT24C256 device.
+ * @param  memoryAddr       Memory address to read data from.
+ * @param  readDataBuffer   Pointer to the data buffer to store the read data.
+ * @param  readDataSize     Size of the data to be read.
+ * @retval e_Status  Status of the read operation (STATUS_OK or STATUS_NOT_OK).
+ */
+e_Status AT24C256_MemoryRead(I2C_HandleTypeDef *i2cHandle, uint8_t deviceAddr, uint16_t memoryAddr, uint8_t *readDataBuffer, uint16_t readDataSize)
+{
+    return HAL_I2C_Mem_Read(i2cHandle, deviceAddr, memoryAddr, AT24C256_MEMORY_REG_SIZE, readDataBuffer, readDataSize, AT24C256_TIMEOUT);
+}
+
+
+#endif /* AT24C256_CFG_H_ */
@@ -0,0 +1,343 @@
+/**
+ * @file at24c256_sim.c
+ * @brief Host simulator of the AT24C256 driver on a model of the EEPROM
+ *
+ * The model has the 64 bytes pages (a page write wraps inside its page), the self-timed write
+ * cycle during which the address is not acknowledged, the sequential read over the whole memory
+ * and the bus time at 400 kHz. It counts the write cycles and the bytes written. The checks write
+ * random data at random addresses and lengths and read it back, then measure the write throughput
+ * against byte writes and page writes with a fixed 5 ms delay, and check the timeout of a write
+ * cycle that does not end.
+ *
+ * Build and run from the root of the repository:
+ *   gcc -std=c99 -Wall -I Misc -I Storage/EEPROM/AT24C256/test/stub -I Storage/EEPROM/AT24C256/src
+ *       Storage/EEPROM/AT24C256/test/at24c256_sim.c Storage/EEPROM/AT24C256/src/at24c256.c
+ *       -o at24c256_sim && ./at24c256_sim
+ *
+ * The exit code is 0 when all the checks pass.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <at24c256.h>
+
+/* Macro Definition -----------------------------------*/
+#define SIM_BIT_TIME_US				2.5			/* 400 kHz, 9 bits per byte with the acknowledge */
+#define SIM_WRITE_COUNT				20000L		/* Random writes of the page split check */
+#define SIM_WRITE_SIZE_MAX			300u		/* Up to 6 pages per write */
+#define SIM_BLOCK_ADDRESS			0x1000u		/* Block of the throughput check */
+#define SIM_BLOCK_SIZE				4096u
+#define SIM_FIXED_DELAY				5u			/* in ms, fixed wait after a write of the previous code */
+#define SIM_POLL_TIMEOUT			(2u * AT24C256_WRITE_CYCLE_TIME)	/* in ms, AT24C256_POLL_TIMEOUT of at24c256_cfg.h */
+
+/* Structures -----------------------------------------*/
+
+/* Memory and write cycle of the AT24C256 */
+typedef struct
+{
+	uint8_t   memory[AT24C256_MEMORY_SIZE];
+	double    writeCycleTime;		/* in us, at most AT24C256_WRITE_CYCLE_TIME */
+	double    busyUntil;			/* End of the write cycle in progress */
+	uint32_t  writeCycleCount;
+	uint32_t  writeByteCount;
+	uint32_t  crossCount;			/* Page writes wrapped inside their page */
+}st_SimEeprom;
+
+/* Variables ------------------------------------------*/
+I2C_HandleTypeDef hi2c1;
+
+static double simTime = 0.0;				/* in us */
+static st_SimEeprom model;
+static st_AT24C256Handle eeprom;
+
+static uint8_t reference[AT24C256_MEMORY_SIZE];
+static uint8_t readBuffer[AT24C256_MEMORY_SIZE];
+
+/* Static Function Declaration ------------------------*/
+static void SIM_Bus(uint32_t byteCount);
+static uint8_t SIM_Acknowledge(void);
+static void SIM_Fill(uint8_t *data, uint16_t size);
+static int SIM_PageSplit(void);
+static int SIM_Throughput(void);
+static int SIM_Timeout(void);
+
+/* HAL model ------------------------------------------*/
+
+void HAL_Delay(uint32_t Delay)
+{
+	simTime += Delay * 1000.0;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return (uint32_t)(simTime / 1000.0);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+	(void)hi2c; (void)Trials; (void)Timeout;
+
+	return ( (DevAddress == AT24C256_I2C_WRITE_ADDRESS) && (SIM_Acknowledge() == 1u) ) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+	uint16_t pageStart = MemAddress & (uint16_t)~AT24C256_PAGE_MASK;
+
+	(void)hi2c; (void)Timeout;
+
+	if( (DevAddress == AT24C256_I2C_WRITE_ADDRESS) && (MemAddSize == I2C_MEMADD_SIZE_16BIT) && (SIM_Acknowledge() == 1u) )
+	{
+		SIM_Bus(2u + Size);
+
+		/* The address counter wraps inside the page, the bytes past its end overwrite its start */
+		model.crossCount += ( ((MemAddress & AT24C256_PAGE_MASK) + Size) > AT24C256_PAGE_SIZE );
+		for(uint16_t index = 0u; index < Size; index++)
+		{
+			model.memory[pageStart | ((MemAddress + index) & AT24C256_PAGE_MASK)] = pData[index];
+		}
+
+		/* The write cycle starts at the stop condition */
+		model.busyUntil = simTime + model.writeCycleTime;
+		model.writeCycleCount++;
+		model.writeByteCount += Size;
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	HAL_StatusTypeDef returnValue = HAL_ERROR;
+
+	(void)hi2c; (void)Timeout;
+
+	if( (DevAddress == AT24C256_I2C_WRITE_ADDRESS) && (MemAddSize == I2C_MEMADD_SIZE_16BIT) && (SIM_Acknowledge() == 1u) )
+	{
+		/* Dummy write of the address, repeated start, then the sequential read over the whole memory */
+		SIM_Bus(3u + Size);
+		for(uint16_t index = 0u; index < Size; index++)
+		{
+			pData[index] = model.memory[(MemAddress + index) % AT24C256_MEMORY_SIZE];
+		}
+		returnValue = HAL_OK;
+	}
+
+	return returnValue;
+}
+
+/* Static Function Definition -------------------------*/
+
+static void SIM_Bus(uint32_t byteCount)
+{
+	simTime += byteCount * 9u * SIM_BIT_TIME_US;
+}
+
+static uint8_t SIM_Acknowledge(void)
+{
+	uint8_t returnValue = 0u;
+
+	/* The address byte is sent in any case, the EEPROM does not answer during a write cycle */
+	SIM_Bus(1u);
+
+	if(simTime >= model.busyUntil)
+	{
+		returnValue = 1u;
+	}
+
+	return returnValue;
+}
+
+static void SIM_Fill(uint8_t *data, uint16_t size)
+{
+	for(uint16_t index = 0u; index < size; index++)
+	{
+		data[index] = (uint8_t)rand();
+	}
+}
+
+static int SIM_PageSplit(void)
+{
+	int failCount = 0;
+	st_AT24C256Statistics statistics;
+	uint8_t data[SIM_WRITE_SIZE_MAX];
+	uint16_t address = 0u;
+	uint16_t size = 0u;
+	uint32_t pageCount = 0u;
+	uint32_t cycleCount = 0u;
+	uint32_t badCount = 0u;
+
+	printf("Page split: %ld random writes of 1 to %u bytes, each read back\n", SIM_WRITE_COUNT, SIM_WRITE_SIZE_MAX);
+	memset(&model, 0, sizeof(model));
+	memset(model.memory, 0xFF, sizeof(model.memory));
+	memset(reference, 0xFF, sizeof(reference));
+	model.writeCycleTime = AT24C256_WRITE_CYCLE_TIME * 1000.0;
+	failCount += (AT24C256_Init(&eeprom, &hi2c1, AT24C256_I2C_WRITE_ADDRESS) != STATUS_OK);
+
+	for(long write = 0L; write < SIM_WRITE_COUNT; write++)
+	{
+		size = (uint16_t)(1u + ((uint32_t)rand() % SIM_WRITE_SIZE_MAX));
+		address = (uint16_t)((uint32_t)rand() % (AT24C256_MEMORY_SIZE - size + 1u));
+		SIM_Fill(data, size);
+		memcpy(&reference[address], data, size);
+
+		/* One write cycle per page touched */
+		pageCount = ((address + size - 1u) / AT24C256_PAGE_SIZE) - (address / AT24C256_PAGE_SIZE) + 1u;
+		cycleCount = model.writeCycleCount;
+		failCount += (AT24C256_Write(&eeprom, address, data, size) != STATUS_OK);
+		badCount += ((model.writeCycleCount - cycleCount) != pageCount);
+
+		failCount += (AT24C256_Read(&eeprom, address, readBuffer, size) != STATUS_OK);
+		badCount += (memcmp(readBuffer, &reference[address], size) != 0);
+	}
+
+	/* The whole memory in one sequential read */
+	failCount += (AT24C256_Read(&eeprom, 0u, readBuffer, AT24C256_MEMORY_SIZE) != STATUS_OK);
+	badCount += (memcmp(readBuffer, reference, AT24C256_MEMORY_SIZE) != 0);
+
+	/* Accesses past the end of the memory or empty are refused without a write cycle */
+	cycleCount = model.writeCycleCount;
+	failCount += (AT24C256_Write(&eeprom, AT24C256_MEMORY_SIZE - 8u, data, 16u) != STATUS_NOT_OK);
+	failCount += (AT24C256_Write(&eeprom, 0u, data, 0u) != STATUS_NOT_OK);
+	failCount += (AT24C256_Read(&eeprom, AT24C256_MEMORY_SIZE - 1u, readBuffer, 2u) != STATUS_NOT_OK);
+	failCount += (model.writeCycleCount != cycleCount);
+
+	AT24C256_GetStatistics(&eeprom, &statistics);
+	printf("  %u bytes in %u write cycles, %u wrapped in a page, %u mismatches\n", model.writeByteCount, model.writeCycleCount, model.crossCount, badCount);
+	failCount += (int)badCount + (int)model.crossCount;
+	failCount += (statistics.writeCycleCount != model.writeCycleCount) + (statistics.writeByteCount != model.writeByteCount);
+
+	return failCount;
+}
+
+static int SIM_Throughput(void)
+{
+	int failCount = 0;
+	st_AT24C256Statistics statistics;
+	static const double writeCycleTime[] = {3000.0, AT24C256_WRITE_CYCLE_TIME * 1000.0};
+	double startTime = 0.0;
+	double byteRate = 0.0;
+	double fixedRate = 0.0;
+	double pollRate = 0.0;
+	uint32_t cycleCount = 0u;
+
+	printf("Throughput: %u bytes at 0x%04X\n", SIM_BLOCK_SIZE, SIM_BLOCK_ADDRESS);
+
+	for(uint8_t index = 0u; index < (sizeof(writeCycleTime) / sizeof(writeCycleTime[0])); index++)
+	{
+		memset(&model, 0, sizeof(model));
+		model.writeCycleTime = writeCycleTime[index];
+		failCount += (AT24C256_Init(&eeprom, &hi2c1, AT24C256_I2C_WRITE_ADDRESS) != STATUS_OK);
+		printf("  %.0f ms write cycle:\n", model.writeCycleTime / 1000.0);
+
+		/* Previous code: one byte per write cycle, fixed delay */
+		SIM_Fill(reference, SIM_BLOCK_SIZE);
+		startTime = simTime;
+		cycleCount = model.writeCycleCount;
+		for(uint16_t offset = 0u; offset < SIM_BLOCK_SIZE; offset++)
+		{
+			failCount += (HAL_I2C_Mem_Write(&hi2c1, AT24C256_I2C_WRITE_ADDRESS, SIM_BLOCK_ADDRESS + offset, I2C_MEMADD_SIZE_16BIT, &reference[offset], 1u, 100u) != HAL_OK);
+			HAL_Delay(SIM_FIXED_DELAY);
+		}
+		byteRate = SIM_BLOCK_SIZE / ((simTime - startTime) / 1e6);
+		printf("    byte writes, %u ms delay:   %7.0f bytes/s, %u write cycles\n", SIM_FIXED_DELAY, byteRate, model.writeCycleCount - cycleCount);
+		failCount += (AT24C256_Read(&eeprom, SIM_BLOCK_ADDRESS, readBuffer, SIM_BLOCK_SIZE) != STATUS_OK);
+		failCount += (memcmp(readBuffer, reference, SIM_BLOCK_SIZE) != 0);
+
+		/* Page writes, fixed delay */
+		SIM_Fill(reference, SIM_BLOCK_SIZE);
+		startTime = simTime;
+		cycleCount = model.writeCycleCount;
+		for(uint16_t offset = 0u; offset < SIM_BLOCK_SIZE; offset += AT24C256_PAGE_SIZE)
+		{
+			failCount += (HAL_I2C_Mem_Write(&hi2c1, AT24C256_I2C_WRITE_ADDRESS, SIM_BLOCK_ADDRESS + offset, I2C_MEMADD_SIZE_16BIT, &reference[offset], AT24C256_PAGE_SIZE, 100u) != HAL_OK);
+			HAL_Delay(SIM_FIXED_DELAY);
+		}
+		fixedRate = SIM_BLOCK_SIZE / ((simTime - startTime) / 1e6);
+		printf("    page writes, %u ms delay:   %7.0f bytes/s, %u write cycles\n", SIM_FIXED_DELAY, fixedRate, model.writeCycleCount - cycleCount);
+		failCount += (AT24C256_Read(&eeprom, SIM_BLOCK_ADDRESS, readBuffer, SIM_BLOCK_SIZE) != STATUS_OK);
+		failCount += (memcmp(readBuffer, reference, SIM_BLOCK_SIZE) != 0);
+
+		/* Driver: page writes and ACK polling, the last write cycle included */
+		SIM_Fill(reference, SIM_BLOCK_SIZE);
+		AT24C256_ResetStatistics(&eeprom);
+		startTime = simTime;
+		failCount += (AT24C256_Write(&eeprom, SIM_BLOCK_ADDRESS, reference, SIM_BLOCK_SIZE) != STATUS_OK);
+		failCount += (AT24C256_WaitReady(&eeprom) != STATUS_OK);
+		pollRate = SIM_BLOCK_SIZE / ((simTime - startTime) / 1e6);
+		AT24C256_GetStatistics(&eeprom, &statistics);
+		printf("    AT24C256_Write(), polling: %7.0f bytes/s, %u write cycles, %.1f polls per cycle\n", pollRate, statistics.writeCycleCount,
+				(double)statistics.pollCount / statistics.writeCycleCount);
+		failCount += (statistics.writeCycleCount != (SIM_BLOCK_SIZE / AT24C256_PAGE_SIZE));
+
+		/* Faster than the fixed delay unless the write cycle takes its maximum, then within the polling overhead */
+		failCount += (model.writeCycleTime < (AT24C256_WRITE_CYCLE_TIME * 1000.0)) ? (pollRate <= fixedRate) : (pollRate < (0.99 * fixedRate));
+
+		/* One sequential read */
+		startTime = simTime;
+		failCount += (AT24C256_Read(&eeprom, SIM_BLOCK_ADDRESS, readBuffer, SIM_BLOCK_SIZE) != STATUS_OK);
+		printf("    AT24C256_Read():           %7.0f bytes/s\n", SIM_BLOCK_SIZE / ((simTime - startTime) / 1e6));
+		failCount += (memcmp(readBuffer, reference, SIM_BLOCK_SIZE) != 0);
+	}
+
+	return failCount;
+}
+
+static int SIM_Timeout(void)
+{
+	int failCount = 0;
+	st_AT24C256Statistics statistics;
+	uint8_t data[4u] = {0x12, 0x34, 0x56, 0x78};
+	double startTime = 0.0;
+
+	printf("Timeout: write cycle that does not end, reset during a write cycle\n");
+	memset(&model, 0, sizeof(model));
+	model.writeCycleTime = AT24C256_WRITE_CYCLE_TIME * 1000.0;
+	failCount += (AT24C256_Init(&eeprom, &hi2c1, AT24C256_I2C_WRITE_ADDRESS) != STATUS_OK);
+
+	/* A write cycle that does not end: the next write gives up after the poll timeout */
+	failCount += (AT24C256_Write(&eeprom, 0x0100u, data, sizeof(data)) != STATUS_OK);
+	model.busyUntil = simTime + 1e9;
+	startTime = simTime;
+	failCount += (AT24C256_Write(&eeprom, 0x0200u, data, sizeof(data)) != STATUS_TIMEOUT);
+	printf("  STATUS_TIMEOUT after %.1f ms,", (simTime - startTime) / 1000.0);
+	failCount += ((simTime - startTime) < (SIM_POLL_TIMEOUT * 1000.0)) + ((simTime - startTime) > ((SIM_POLL_TIMEOUT + 1u) * 1000.0));
+	failCount += (model.writeCycleCount != 1u);
+
+	/* A reset of the MCU during a write cycle: the initialization waits for its end */
+	model.busyUntil = simTime + 4000.0;
+	startTime = simTime;
+	failCount += (AT24C256_Init(&eeprom, &hi2c1, AT24C256_I2C_WRITE_ADDRESS) != STATUS_OK);
+	AT24C256_GetStatistics(&eeprom, &statistics);
+	printf(" initialization ready after %.1f ms and %u polls\n", (simTime - startTime) / 1000.0, statistics.pollCount);
+	failCount += ((simTime - startTime) < 4000.0) + (statistics.pollCount == 0u);
+
+	failCount += (AT24C256_Write(&eeprom, 0x0100u, data, sizeof(data)) != STATUS_OK);
+	failCount += (AT24C256_Read(&eeprom, 0x0100u, readBuffer, sizeof(data)) != STATUS_OK);
+	failCount += (memcmp(readBuffer, data, sizeof(data)) != 0);
+
+	return failCount;
+}
+
+/* Function Definition --------------------------------*/
+
+int main(void)
+{
+	int failCount = 0;
+
+	srand(7u);
+	failCount += SIM_PageSplit();
+	failCount += SIM_Throughput();
+	failCount += SIM_Timeout();
+	printf("%s\n", (failCount == 0) ? "PASS" : "FAIL");
+
+	return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file i2c.h
+ * @brief Host stand-in of the CubeMX I2C header for the AT24C256 simulator
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef I2C_H_
+#define I2C_H_
+
+/* Includes -------------------------------------------*/
+#include <stm32f0xx_hal.h>
+
+/* Variables ------------------------------------------*/
+extern I2C_HandleTypeDef hi2c1;
+
+
+#endif /* I2C_H_ */
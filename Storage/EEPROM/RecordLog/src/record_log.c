@@ -0,0 +1,894 @@
+/**
+ * @file record_log.c
+ * @brief Log-structured record store on the AT24C256 EEPROM
+ *
+ * This file contains the implementation of the record log.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+
+/* Includes -------------------------------------------*/
+#include <string.h>
+#include <crc8.h>
+#include "record_log.h"
+#include "record_log_cfg.h"
+
+/* Variables ------------------------------------------*/
+
+
+/* Static Function Declaration ------------------------*/
+/**
+ * @brief Gets the EEPROM address of a page of the ring.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] page Index of the page in the ring.
+ * @return uint16_t Memory address of the first byte of the page.
+ */
+static uint16_t RECORDLOG_PageAddress(st_RecordLogHandle *log, uint16_t page);
+
+/**
+ * @brief Gets the page following a page of the ring.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] page Index of the page in the ring.
+ * @return uint16_t Index of the next page, the first page after the last one.
+ */
+static uint16_t RECORDLOG_NextPage(st_RecordLogHandle *log, uint16_t page);
+
+/**
+ * @brief Decodes the sequence number of a page header.
+ *
+ * @param[in] header Pointer to the page header.
+ * @return uint32_t Sequence number, RECORDLOG_SEQUENCE_NONE if the page is erased or corrupted.
+ */
+static uint32_t RECORDLOG_DecodeSequence(const uint8_t *header);
+
+/**
+ * @brief Reads the sequence number of a page from the EEPROM.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] page Index of the page in the ring.
+ * @param[out] sequence Pointer to store the sequence number, RECORDLOG_SEQUENCE_NONE if invalid.
+ * @return e_Status STATUS_OK if read, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_ReadSequence(st_RecordLogHandle *log, uint16_t page, uint32_t *sequence);
+
+/**
+ * @brief Reads a whole page, the head page is read from its image.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] page Index of the page in the ring.
+ * @param[out] pageBuffer Pointer to store the page (RECORDLOG_PAGE_SIZE bytes).
+ * @return e_Status STATUS_OK if read, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_ReadPage(st_RecordLogHandle *log, uint16_t page, uint8_t *pageBuffer);
+
+/**
+ * @brief Checks the record at an offset of a page.
+ *
+ * @param[in] pageBuffer Pointer to the page.
+ * @param[in] offset Offset of the record in the page.
+ * @return uint8_t Size of the record (overhead included), 0 if erased, torn or corrupted.
+ */
+static uint8_t RECORDLOG_RecordSize(const uint8_t *pageBuffer, uint8_t offset);
+
+/**
+ * @brief Finds the latest record of a key, if not already known since the mount.
+ *
+ * The pages are searched from the head to the oldest one, the search stops at the first page
+ * holding the key or at a page out of the sequence (erased, torn or of an older lap).
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] key Key of the record.
+ * @return e_Status STATUS_OK if the key state is known, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_FindKey(st_RecordLogHandle *log, uint8_t key);
+
+/**
+ * @brief Copies the latest records of a page into the image of the new head page.
+ *
+ * Only a page of the current lap (its sequence number is the expected one) is collected. The other
+ * records of the page (stream or older) are dropped when the page is reused.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] page Index of the collected page in the ring.
+ * @param[in] sequence Sequence number of the collected page in the current lap.
+ * @param[in,out] newImage Image of the new head page.
+ * @param[in,out] newOffset First free byte of the image.
+ * @return e_Status STATUS_OK if collected, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_CollectPage(st_RecordLogHandle *log, uint16_t page, uint32_t sequence, uint8_t *newImage, uint8_t *newOffset);
+
+/**
+ * @brief Closes the head page and starts the next page of the ring.
+ *
+ * The page after the new head page is the next one to be reused, its latest records are copied
+ * into the new head page first. When it is overwritten, one page later, the copies are already in
+ * the EEPROM. If a reset tore the copies, the mount starts the head page again.
+ *
+ * @param[in] log Context of the record log.
+ * @return e_Status STATUS_OK if started, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_OpenPage(st_RecordLogHandle *log);
+
+/**
+ * @brief Starts the head page again if a reset tore its copies of the garbage collection.
+ *
+ * The copies are in the first write of the head page. If it was torn, the latest records are still
+ * only in the page after it, which the next page would overwrite. The head page is then started
+ * again from the previous page, the page after it is untouched until the new copies are written.
+ *
+ * @param[in] log Context of the record log, mounted on a closed head page.
+ * @return e_Status STATUS_OK if checked (and started again), STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_RepairHead(st_RecordLogHandle *log);
+
+/**
+ * @brief Finds the head page and the end of its records.
+ *
+ * The sequence numbers increase along the ring from the first page up to the head page and are
+ * lower after it (older lap or erased), so the head is the last page whose sequence number is at
+ * least the one of the first page: a binary search over the page headers.
+ *
+ * @param[in] log Context of the record log.
+ * @return e_Status STATUS_OK if mounted, STATUS_NOT_OK or STATUS_TIMEOUT otherwise.
+ */
+static e_Status RECORDLOG_Mount(st_RecordLogHandle *log);
+
+/* Static Function Definition -------------------------*/
+
+static uint16_t RECORDLOG_PageAddress(st_RecordLogHandle *log, uint16_t page)
+{
+	return (uint16_t)((log->firstPage + page) * RECORDLOG_PAGE_SIZE);
+}
+
+static uint16_t RECORDLOG_NextPage(st_RecordLogHandle *log, uint16_t page)
+{
+	uint16_t returnValue = 0u;
+
+	if( (page + 1u) < log->pageCount )
+	{
+		returnValue = page + 1u;
+	}
+
+	return returnValue;
+}
+
+static uint32_t RECORDLOG_DecodeSequence(const uint8_t *header)
+{
+	uint32_t returnValue = RECORDLOG_SEQUENCE_NONE;
+
+	returnValue = (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+
+	if( (returnValue == RECORDLOG_SEQUENCE_ERASED) || (CRC8_Calculate(header, 4u, CRC8_INIT) != header[4]) )
+	{
+		returnValue = RECORDLOG_SEQUENCE_NONE;
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_ReadSequence(st_RecordLogHandle *log, uint16_t page, uint32_t *sequence)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t header[RECORDLOG_HEADER_SIZE] = {0};
+
+	returnValue = RECORDLOG_DeviceRead(log->eeprom, RECORDLOG_PageAddress(log, page), header, RECORDLOG_HEADER_SIZE);
+
+	if(returnValue == STATUS_OK)
+	{
+		*sequence = RECORDLOG_DecodeSequence(header);
+		log->statistics.mountReadCount++;
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_ReadPage(st_RecordLogHandle *log, uint16_t page, uint8_t *pageBuffer)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (log->headSequence != RECORDLOG_SEQUENCE_NONE) && (page == log->headPage) )
+	{
+		/* The image holds the records not flushed yet */
+		memcpy(pageBuffer, log->pageImage, RECORDLOG_PAGE_SIZE);
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		returnValue = RECORDLOG_DeviceRead(log->eeprom, RECORDLOG_PageAddress(log, page), pageBuffer, RECORDLOG_PAGE_SIZE);
+	}
+
+	return returnValue;
+}
+
+static uint8_t RECORDLOG_RecordSize(const uint8_t *pageBuffer, uint8_t offset)
+{
+	uint8_t returnValue = 0u;
+	uint8_t dataSize = 0u;
+
+	if( (offset + RECORDLOG_RECORD_OVERHEAD) <= RECORDLOG_PAGE_SIZE )
+	{
+		dataSize = pageBuffer[offset + 1u];
+
+		/* An erased key is the end of the records, a wrong length or CRC is a record torn by a reset */
+		if( (pageBuffer[offset] < RECORDLOG_KEY_COUNT) && ((offset + RECORDLOG_RECORD_OVERHEAD + dataSize) <= RECORDLOG_PAGE_SIZE) )
+		{
+			if(CRC8_Calculate(&pageBuffer[offset], 2u + dataSize, CRC8_INIT) == pageBuffer[offset + 2u + dataSize])
+			{
+				returnValue = RECORDLOG_RECORD_OVERHEAD + dataSize;
+			}
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_FindKey(st_RecordLogHandle *log, uint8_t key)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t pageBuffer[RECORDLOG_PAGE_SIZE] = {0};
+	uint16_t page = log->headPage;
+	uint32_t sequence = log->headSequence;
+	uint16_t remaining = log->pageCount;
+	uint8_t offset = 0u;
+	uint8_t recordSize = 0u;
+
+	while( (log->keyState[key] == RECORDLOG_KEY_UNKNOWN) && (returnValue == STATUS_OK) )
+	{
+		if( (remaining == 0u) || (sequence == RECORDLOG_SEQUENCE_NONE) )
+		{
+			log->keyState[key] = RECORDLOG_KEY_ABSENT;
+		}
+		else
+		{
+			returnValue = RECORDLOG_ReadPage(log, page, pageBuffer);
+		}
+
+		if( (returnValue == STATUS_OK) && (log->keyState[key] == RECORDLOG_KEY_UNKNOWN) )
+		{
+			log->statistics.scanPageCount++;
+
+			if(RECORDLOG_DecodeSequence(pageBuffer) == sequence)
+			{
+				/* The last record of the key in the page is the latest one */
+				offset = RECORDLOG_HEADER_SIZE;
+				recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+
+				while(recordSize != 0u)
+				{
+					if(pageBuffer[offset] == key)
+					{
+						log->keyState[key] = RECORDLOG_KEY_FOUND;
+						log->keyPage[key] = page;
+						log->keyOffset[key] = offset;
+					}
+
+					offset += recordSize;
+					recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+				}
+
+				/* Previous page of the ring */
+				page = (page == 0u) ? (log->pageCount - 1u) : (page - 1u);
+				sequence--;
+				remaining--;
+			}
+			else
+			{
+				/* Erased, torn or older lap: beginning of the log */
+				log->keyState[key] = RECORDLOG_KEY_ABSENT;
+			}
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_CollectPage(st_RecordLogHandle *log, uint16_t page, uint32_t sequence, uint8_t *newImage, uint8_t *newOffset)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t pageBuffer[RECORDLOG_PAGE_SIZE] = {0};
+	uint16_t newPage = RECORDLOG_NextPage(log, log->headPage);
+	uint8_t offset = RECORDLOG_HEADER_SIZE;
+	uint8_t recordSize = 0u;
+	uint8_t key = 0u;
+
+	returnValue = RECORDLOG_ReadPage(log, page, pageBuffer);
+
+	if( (returnValue == STATUS_OK) && (sequence != RECORDLOG_SEQUENCE_NONE) && (RECORDLOG_DecodeSequence(pageBuffer) == sequence) )
+	{
+		recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+
+		while( (recordSize != 0u) && (returnValue == STATUS_OK) )
+		{
+			key = pageBuffer[offset];
+
+			if(key != RECORDLOG_KEY_STREAM)
+			{
+				returnValue = RECORDLOG_FindKey(log, key);
+			}
+
+			if( (key != RECORDLOG_KEY_STREAM) && (log->keyState[key] == RECORDLOG_KEY_FOUND)
+				&& (log->keyPage[key] == page) && (log->keyOffset[key] == offset) )
+			{
+				/* Latest record of the key */
+				memcpy(&newImage[*newOffset], &pageBuffer[offset], recordSize);
+				log->keyPage[key] = newPage;
+				log->keyOffset[key] = *newOffset;
+				*newOffset += recordSize;
+				log->statistics.relocatedCount++;
+			}
+			else
+			{
+				log->statistics.droppedCount++;
+			}
+
+			offset += recordSize;
+			recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_OpenPage(st_RecordLogHandle *log)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t newImage[RECORDLOG_PAGE_SIZE] = {0};
+	uint32_t newSequence = log->headSequence + 1u;
+	uint16_t nextPage = RECORDLOG_NextPage(log, log->headPage);
+	uint16_t reusedPage = RECORDLOG_NextPage(log, nextPage);
+	uint32_t reusedSequence = RECORDLOG_SEQUENCE_NONE;
+	uint8_t newOffset = RECORDLOG_HEADER_SIZE;
+	uint8_t key = 0u;
+
+	/* The records of the head page must be in the EEPROM before the copies of the garbage collection */
+	returnValue = RECORDLOG_Flush(log);
+
+	memset(newImage, RECORDLOG_ERASED, RECORDLOG_PAGE_SIZE);
+	newImage[0] = (uint8_t)newSequence;
+	newImage[1] = (uint8_t)(newSequence >> 8);
+	newImage[2] = (uint8_t)(newSequence >> 16);
+	newImage[3] = (uint8_t)(newSequence >> 24);
+	newImage[4] = CRC8_Calculate(newImage, 4u, CRC8_INIT);
+
+	/* Sequence number of the page reused after the new one, in the current lap */
+	if(newSequence >= log->pageCount)
+	{
+		reusedSequence = newSequence + 1u - log->pageCount;
+	}
+
+	/* Only a stream record can be the latest one in the overwritten page, the latest records of the
+	 * other keys were copied when the head page was started (again by the mount if a reset tore them) */
+	if( (log->keyState[RECORDLOG_KEY_STREAM] == RECORDLOG_KEY_FOUND) && (log->keyPage[RECORDLOG_KEY_STREAM] == nextPage) )
+	{
+		log->keyState[RECORDLOG_KEY_STREAM] = RECORDLOG_KEY_ABSENT;
+	}
+
+	/* Garbage collection of the page reused after the new one, its records come from one page so they fit */
+	if(returnValue == STATUS_OK)
+	{
+		returnValue = RECORDLOG_CollectPage(log, reusedPage, reusedSequence, newImage, &newOffset);
+	}
+
+	if(returnValue == STATUS_OK)
+	{
+		/* Written as a whole page by the next flush, which also erases the records of the previous lap */
+		memcpy(log->pageImage, newImage, RECORDLOG_PAGE_SIZE);
+		log->headPage = nextPage;
+		log->headSequence = newSequence;
+		log->headOffset = newOffset;
+		log->flushedOffset = 0u;
+		log->statistics.pageOpenCount++;
+	}
+	else
+	{
+		/* The locations may point to the image not started, looked up again */
+		for(key = 0u; key < RECORDLOG_KEY_COUNT; key++)
+		{
+			log->keyState[key] = RECORDLOG_KEY_UNKNOWN;
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_RepairHead(st_RecordLogHandle *log)
+{
+	e_Status returnValue = STATUS_OK;
+	uint8_t pageBuffer[RECORDLOG_PAGE_SIZE] = {0};
+	uint16_t reusedPage = RECORDLOG_NextPage(log, log->headPage);
+	uint8_t offset = RECORDLOG_HEADER_SIZE;
+	uint8_t recordSize = 0u;
+	uint8_t key = 0u;
+	uint8_t copyTorn = 0u;
+
+	/* The page after the head page holds records of the current lap once the ring has wrapped */
+	if(log->headSequence >= log->pageCount)
+	{
+		returnValue = RECORDLOG_ReadPage(log, reusedPage, pageBuffer);
+
+		if( (returnValue == STATUS_OK) && (RECORDLOG_DecodeSequence(pageBuffer) == (log->headSequence + 1u - log->pageCount)) )
+		{
+			recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+
+			while( (recordSize != 0u) && (returnValue == STATUS_OK) && (copyTorn == 0u) )
+			{
+				key = pageBuffer[offset];
+
+				if(key != RECORDLOG_KEY_STREAM)
+				{
+					returnValue = RECORDLOG_FindKey(log, key);
+
+					/* Still the latest record: its copy is missing from the head page */
+					if( (returnValue == STATUS_OK) && (log->keyState[key] == RECORDLOG_KEY_FOUND)
+						&& (log->keyPage[key] == reusedPage) && (log->keyOffset[key] == offset) )
+					{
+						copyTorn = 1u;
+					}
+				}
+
+				offset += recordSize;
+				recordSize = RECORDLOG_RecordSize(pageBuffer, offset);
+			}
+		}
+	}
+
+	if( (returnValue == STATUS_OK) && (copyTorn == 1u) )
+	{
+		/* Back to the previous page, closed. Its records and the copies are all that the torn page held
+		 * in the EEPROM, apart from records not acknowledged before the reset */
+		log->headPage = (log->headPage == 0u) ? (log->pageCount - 1u) : (log->headPage - 1u);
+		log->headSequence--;
+		returnValue = RECORDLOG_DeviceRead(log->eeprom, RECORDLOG_PageAddress(log, log->headPage), log->pageImage, RECORDLOG_PAGE_SIZE);
+
+		if(returnValue == STATUS_OK)
+		{
+			log->headOffset = RECORDLOG_PAGE_SIZE;
+			log->flushedOffset = RECORDLOG_PAGE_SIZE;
+
+			for(key = 0u; key < RECORDLOG_KEY_COUNT; key++)
+			{
+				log->keyState[key] = RECORDLOG_KEY_UNKNOWN;
+			}
+
+			returnValue = RECORDLOG_OpenPage(log);
+		}
+
+		/* The copies are in the EEPROM before any record is appended after them */
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = RECORDLOG_Flush(log);
+			log->statistics.repairCount++;
+		}
+	}
+
+	return returnValue;
+}
+
+static e_Status RECORDLOG_Mount(st_RecordLogHandle *log)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint32_t firstSequence = RECORDLOG_SEQUENCE_NONE;
+	uint32_t sequence = RECORDLOG_SEQUENCE_NONE;
+	uint16_t low = 0u;
+	uint16_t high = log->pageCount - 1u;
+	uint16_t middle = 0u;
+	uint8_t offset = RECORDLOG_HEADER_SIZE;
+	uint8_t recordSize = 0u;
+	uint8_t key = 0u;
+
+	/* Empty log: the first append starts the first page */
+	log->headPage = log->pageCount - 1u;
+	log->headSequence = RECORDLOG_SEQUENCE_NONE;
+	log->headOffset = RECORDLOG_PAGE_SIZE;
+	log->flushedOffset = RECORDLOG_PAGE_SIZE;
+	log->statistics.mountReadCount = 0u;
+
+	for(key = 0u; key < RECORDLOG_KEY_COUNT; key++)
+	{
+		log->keyState[key] = RECORDLOG_KEY_UNKNOWN;
+	}
+
+	returnValue = RECORDLOG_ReadSequence(log, 0u, &firstSequence);
+
+	if( (returnValue == STATUS_OK) && (firstSequence == RECORDLOG_SEQUENCE_NONE) )
+	{
+		/* First page erased, or torn by a reset when the ring wrapped to it: then the last page is the head */
+		returnValue = RECORDLOG_ReadSequence(log, log->pageCount - 1u, &sequence);
+		log->headSequence = sequence;
+	}
+	else if(returnValue == STATUS_OK)
+	{
+		/* Last page with a sequence number at least the one of the first page */
+		log->headSequence = firstSequence;
+
+		while( (low < high) && (returnValue == STATUS_OK) )
+		{
+			middle = low + ((high - low + 1u) / 2u);
+			returnValue = RECORDLOG_ReadSequence(log, middle, &sequence);
+
+			if( (sequence != RECORDLOG_SEQUENCE_NONE) && (sequence >= firstSequence) )
+			{
+				low = middle;
+				log->headSequence = sequence;
+			}
+			else
+			{
+				high = middle - 1u;
+			}
+		}
+
+		log->headPage = low;
+	}
+	else
+	{
+		/* Error Handling */
+	}
+
+	/* End of the records of the head page */
+	if( (returnValue == STATUS_OK) && (log->headSequence != RECORDLOG_SEQUENCE_NONE) )
+	{
+		returnValue = RECORDLOG_DeviceRead(log->eeprom, RECORDLOG_PageAddress(log, log->headPage), log->pageImage, RECORDLOG_PAGE_SIZE);
+
+		if(returnValue == STATUS_OK)
+		{
+			recordSize = RECORDLOG_RecordSize(log->pageImage, offset);
+
+			while(recordSize != 0u)
+			{
+				offset += recordSize;
+				recordSize = RECORDLOG_RecordSize(log->pageImage, offset);
+			}
+
+			log->headOffset = offset;
+
+			/* A record torn by a reset: the page is closed, the next append starts a new page */
+			while(offset < RECORDLOG_PAGE_SIZE)
+			{
+				if(log->pageImage[offset] != RECORDLOG_ERASED)
+				{
+					log->headOffset = RECORDLOG_PAGE_SIZE;
+				}
+
+				offset++;
+			}
+
+			log->flushedOffset = log->headOffset;
+		}
+
+		if( (returnValue == STATUS_OK) && (log->headOffset == RECORDLOG_PAGE_SIZE) )
+		{
+			returnValue = RECORDLOG_RepairHead(log);
+		}
+	}
+
+	return returnValue;
+}
+
+/* Function Definition --------------------------------*/
+
+e_Status RECORDLOG_Init(st_RecordLogHandle *log, st_AT24C256Handle *eeprom, uint16_t firstPage, uint16_t pageCount)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (log != NULL) && (eeprom != NULL) )
+	{
+		if( (pageCount >= RECORDLOG_PAGE_MIN) && (((uint32_t)firstPage + pageCount) <= RECORDLOG_PAGE_MAX) )
+		{
+			log->eeprom = eeprom;
+			log->firstPage = firstPage;
+			log->pageCount = pageCount;
+			RECORDLOG_ResetStatistics(log);
+
+			returnValue = RECORDLOG_Mount(log);
+		}
+		else
+		{
+			/* Error Handling */
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_Format(st_RecordLogHandle *log)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint16_t page = 0u;
+
+	if( (log != NULL) && (log->eeprom != NULL) )
+	{
+		returnValue = STATUS_OK;
+		memset(log->pageImage, RECORDLOG_ERASED, RECORDLOG_PAGE_SIZE);
+
+		while( (page < log->pageCount) && (returnValue == STATUS_OK) )
+		{
+			returnValue = RECORDLOG_DeviceWrite(log->eeprom, RECORDLOG_PageAddress(log, page), log->pageImage, RECORDLOG_PAGE_SIZE);
+
+			if(returnValue == STATUS_OK)
+			{
+				log->statistics.writeCycleCount++;
+				log->statistics.writeByteCount += RECORDLOG_PAGE_SIZE;
+			}
+
+			page++;
+		}
+
+		if(returnValue == STATUS_OK)
+		{
+			returnValue = RECORDLOG_Mount(log);
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_Append(st_RecordLogHandle *log, uint8_t key, const uint8_t *data, uint8_t size)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t recordSize = size + RECORDLOG_RECORD_OVERHEAD;
+	uint16_t pageTrial = 0u;
+	uint8_t *record = NULL;
+
+	if( (log != NULL) && (log->eeprom != NULL) && (data != NULL) )
+	{
+		if( (key < RECORDLOG_KEY_COUNT) && (size <= RECORDLOG_DATA_MAX) )
+		{
+			returnValue = STATUS_OK;
+
+			/* The copies of the garbage collection may fill a new page, bounded by the ring */
+			while( (returnValue == STATUS_OK) && ((log->headOffset + recordSize) > RECORDLOG_PAGE_SIZE) )
+			{
+				if(pageTrial < log->pageCount)
+				{
+					returnValue = RECORDLOG_OpenPage(log);
+					pageTrial++;
+				}
+				else
+				{
+					returnValue = STATUS_NOT_OK;
+				}
+			}
+
+			if(returnValue == STATUS_OK)
+			{
+				record = &log->pageImage[log->headOffset];
+				record[0] = key;
+				record[1] = size;
+				memcpy(&record[2], data, size);
+				record[2u + size] = CRC8_Calculate(record, 2u + size, CRC8_INIT);
+
+				log->keyState[key] = RECORDLOG_KEY_FOUND;
+				log->keyPage[key] = log->headPage;
+				log->keyOffset[key] = log->headOffset;
+				log->headOffset += recordSize;
+				log->statistics.appendCount++;
+				log->statistics.payloadByteCount += size;
+
+#if(RECORDLOG_WRITE_THROUGH == 1u)
+				returnValue = RECORDLOG_Flush(log);
+#endif
+			}
+		}
+		else
+		{
+			/* Error Handling */
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_Flush(st_RecordLogHandle *log)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t writeOffset = 0u;
+	uint8_t writeSize = 0u;
+
+	if( (log != NULL) && (log->eeprom != NULL) )
+	{
+		returnValue = STATUS_OK;
+
+		if( (log->headSequence != RECORDLOG_SEQUENCE_NONE) && (log->flushedOffset < log->headOffset) )
+		{
+			if(log->flushedOffset == 0u)
+			{
+				/* New page: written whole, the erased fill overwrites the records of the previous lap */
+				writeSize = RECORDLOG_PAGE_SIZE;
+			}
+			else
+			{
+				writeOffset = log->flushedOffset;
+				writeSize = log->headOffset - log->flushedOffset;
+			}
+
+			returnValue = RECORDLOG_DeviceWrite(log->eeprom, RECORDLOG_PageAddress(log, log->headPage) + writeOffset, &log->pageImage[writeOffset], writeSize);
+
+			if(returnValue == STATUS_OK)
+			{
+				log->flushedOffset = log->headOffset;
+				log->statistics.writeCycleCount++;
+				log->statistics.writeByteCount += writeSize;
+			}
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_ReadLatest(st_RecordLogHandle *log, uint8_t key, uint8_t *data, uint8_t bufferSize, uint8_t *readSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	uint8_t pageBuffer[RECORDLOG_PAGE_SIZE] = {0};
+	uint8_t offset = 0u;
+
+	if( (log != NULL) && (log->eeprom != NULL) && (data != NULL) && (readSize != NULL) && (key < RECORDLOG_KEY_COUNT) )
+	{
+		returnValue = RECORDLOG_FindKey(log, key);
+
+		if( (returnValue == STATUS_OK) && (log->keyState[key] == RECORDLOG_KEY_FOUND) )
+		{
+			offset = log->keyOffset[key];
+			returnValue = RECORDLOG_ReadPage(log, log->keyPage[key], pageBuffer);
+		}
+		else
+		{
+			returnValue = STATUS_NOT_OK;
+		}
+
+		if( (returnValue == STATUS_OK) && (RECORDLOG_RecordSize(pageBuffer, offset) != 0u) && (pageBuffer[offset + 1u] <= bufferSize) )
+		{
+			*readSize = pageBuffer[offset + 1u];
+			memcpy(data, &pageBuffer[offset + 2u], *readSize);
+		}
+		else
+		{
+			returnValue = STATUS_NOT_OK;
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_CursorStart(st_RecordLogHandle *log, st_RecordLogCursor *cursor)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (log != NULL) && (cursor != NULL) )
+	{
+		/* The page after the head is the oldest one once the ring has wrapped */
+		cursor->page = RECORDLOG_NextPage(log, log->headPage);
+		cursor->remaining = (log->headSequence == RECORDLOG_SEQUENCE_NONE) ? 0u : log->pageCount;
+		cursor->offset = 0u;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_CursorNext(st_RecordLogHandle *log, st_RecordLogCursor *cursor, uint8_t *key, uint8_t *data, uint8_t bufferSize, uint8_t *readSize)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+	e_Status readStatus = STATUS_OK;
+	uint8_t recordSize = 0u;
+	uint8_t recordRead = 0u;
+
+	if( (log != NULL) && (cursor != NULL) && (key != NULL) && (data != NULL) && (readSize != NULL) )
+	{
+		while( (cursor->remaining != 0u) && (recordRead == 0u) && (readStatus == STATUS_OK) )
+		{
+			if(cursor->offset == 0u)
+			{
+				readStatus = RECORDLOG_ReadPage(log, cursor->page, cursor->pageBuffer);
+
+				/* Pages of the current lap only, the head page is the last one (remaining is 1) */
+				if( (readStatus == STATUS_OK) && ((cursor->remaining - 1u) < log->headSequence)
+					&& (RECORDLOG_DecodeSequence(cursor->pageBuffer) == (log->headSequence - (cursor->remaining - 1u))) )
+				{
+					cursor->offset = RECORDLOG_HEADER_SIZE;
+				}
+				else
+				{
+					cursor->offset = RECORDLOG_PAGE_SIZE;
+				}
+			}
+
+			if(readStatus == STATUS_OK)
+			{
+				recordSize = RECORDLOG_RecordSize(cursor->pageBuffer, cursor->offset);
+
+				if(recordSize == 0u)
+				{
+					cursor->page = RECORDLOG_NextPage(log, cursor->page);
+					cursor->remaining--;
+					cursor->offset = 0u;
+				}
+				else if(cursor->pageBuffer[cursor->offset + 1u] <= bufferSize)
+				{
+					*key = cursor->pageBuffer[cursor->offset];
+					*readSize = cursor->pageBuffer[cursor->offset + 1u];
+					memcpy(data, &cursor->pageBuffer[cursor->offset + 2u], *readSize);
+					cursor->offset += recordSize;
+					recordRead = 1u;
+					returnValue = STATUS_OK;
+				}
+				else
+				{
+					/* Buffer too small, the cursor stays on the record */
+					readStatus = STATUS_NOT_OK;
+				}
+			}
+		}
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+e_Status RECORDLOG_GetStatistics(st_RecordLogHandle *log, st_RecordLogStatistics *statistics)
+{
+	e_Status returnValue = STATUS_NOT_OK;
+
+	if( (log != NULL) && (statistics != NULL) )
+	{
+		*statistics = log->statistics;
+		returnValue = STATUS_OK;
+	}
+	else
+	{
+		/* Handle null pointer */
+	}
+
+	return returnValue;
+}
+
+void RECORDLOG_ResetStatistics(st_RecordLogHandle *log)
+{
+	if(log != NULL)
+	{
+		log->statistics.appendCount = 0u;
+		log->statistics.payloadByteCount = 0u;
+		log->statistics.writeCycleCount = 0u;
+		log->statistics.writeByteCount = 0u;
+		log->statistics.pageOpenCount = 0u;
+		log->statistics.relocatedCount = 0u;
+		log->statistics.droppedCount = 0u;
+		log->statistics.scanPageCount = 0u;
+		log->statistics.mountReadCount = 0u;
+		log->statistics.repairCount = 0u;
+	}
+}
@@ -0,0 +1,219 @@
+/**
+ * @file record_log.h
+ * @brief Log-structured record store on the AT24C256 EEPROM
+ *
+ * The records are appended to a ring of EEPROM pages, so the writes and the wear are spread over
+ * all the pages instead of rewriting the same page. Each page starts with a header holding its
+ * sequence number, the sequence numbers increase along the ring and the head is found at mount by
+ * a binary search over them. Each record is a key, a length, the data and a CRC-8.
+ *
+ * The records of RECORDLOG_KEY_STREAM (samples) are dropped when their page is reused. For the
+ * other keys (settings, counters) the latest record is kept: it is copied forward by the garbage
+ * collection before its page is reused. If a reset tears the copies, the mount starts the head page
+ * again while the page holding the originals is still intact.
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef RECORD_LOG_H_
+#define RECORD_LOG_H_
+
+/* Includes -------------------------------------------*/
+#include <common.h>
+#include <at24c256.h>
+
+/* Macro Definition -----------------------------------*/
+#define RECORDLOG_PAGE_SIZE					AT24C256_PAGE_SIZE
+#define RECORDLOG_PAGE_MAX					(AT24C256_MEMORY_SIZE / AT24C256_PAGE_SIZE)
+
+/* Page header: sequence number (4 bytes, LSB first) and CRC-8 of the sequence number */
+#define RECORDLOG_HEADER_SIZE				5u
+#define RECORDLOG_SEQUENCE_NONE				0x00000000u		/* Erased or corrupted page, the first page written is 1 */
+#define RECORDLOG_SEQUENCE_ERASED			0xFFFFFFFFu
+
+/* Record: key, length, data and CRC-8 of the key, length and data. A record never crosses a page */
+#define RECORDLOG_RECORD_OVERHEAD			3u
+#define RECORDLOG_DATA_MAX					(RECORDLOG_PAGE_SIZE - RECORDLOG_HEADER_SIZE - RECORDLOG_RECORD_OVERHEAD)
+#define RECORDLOG_ERASED					0xFF			/* Erased byte, a key of 0xFF is the end of the records of the page */
+
+#define RECORDLOG_KEY_STREAM				0x00			/* Samples, the oldest ones are dropped when the log is full */
+
+/* Number of keys (RECORDLOG_KEY_STREAM included), can be overridden from the build flags */
+#ifndef RECORDLOG_KEY_COUNT
+#define RECORDLOG_KEY_COUNT					8u
+#endif
+
+#if(RECORDLOG_KEY_COUNT < 1u) || (RECORDLOG_KEY_COUNT > 255u)
+#error "RECORDLOG_KEY_COUNT must be 1 to 255, the key 0xFF is reserved"
+#endif
+
+/* The latest record of each key fits in one page, one more page is free for the appends */
+#define RECORDLOG_PAGE_MIN					(RECORDLOG_KEY_COUNT + 2u)
+
+#define RECORDLOG_KEY_UNKNOWN				0x00			/* Not looked up since the mount */
+#define RECORDLOG_KEY_FOUND					0x01
+#define RECORDLOG_KEY_ABSENT				0x02
+
+/* Structures -----------------------------------------*/
+
+/* Cost of the log, write amplification is writeByteCount / payloadByteCount */
+typedef struct st_RecordLogStatistics
+{
+	uint32_t  appendCount;			/* Records appended by the application */
+	uint32_t  payloadByteCount;		/* Data bytes of the appended records */
+	uint32_t  writeCycleCount;		/* Page writes, each one is a write cycle of the EEPROM */
+	uint32_t  writeByteCount;		/* Bytes written, headers, record overhead, erased fill and copies included */
+	uint32_t  pageOpenCount;		/* Pages started, the log wraps every pageCount pages */
+	uint32_t  relocatedCount;		/* Latest records copied forward by the garbage collection */
+	uint32_t  droppedCount;			/* Older and stream records given up by the garbage collection */
+	uint32_t  scanPageCount;		/* Pages read to look up the latest record of a key */
+	uint32_t  mountReadCount;		/* Page headers read by the last mount */
+	uint32_t  repairCount;			/* Head pages started again by the mount, a reset tore their copies */
+}st_RecordLogStatistics;
+
+/* Context of one record log, on a range of pages of an EEPROM */
+typedef struct st_RecordLogHandle
+{
+	st_AT24C256Handle  *eeprom;
+	uint16_t            firstPage;		/* First EEPROM page of the log */
+	uint16_t            pageCount;		/* Pages of the ring, at least RECORDLOG_PAGE_MIN */
+
+	/* Head page, the only page being written, its image is kept in RAM */
+	uint16_t            headPage;		/* Index in the ring */
+	uint32_t            headSequence;	/* RECORDLOG_SEQUENCE_NONE while the log is empty */
+	uint8_t             headOffset;		/* First free byte, RECORDLOG_PAGE_SIZE when the page is closed */
+	uint8_t             flushedOffset;	/* Bytes of the image in the EEPROM, 0 until the whole page is written */
+	uint8_t             pageImage[RECORDLOG_PAGE_SIZE];
+
+	/* Location of the latest record of each key, filled on demand */
+	uint8_t             keyState[RECORDLOG_KEY_COUNT];
+	uint16_t            keyPage[RECORDLOG_KEY_COUNT];
+	uint8_t             keyOffset[RECORDLOG_KEY_COUNT];
+
+	st_RecordLogStatistics  statistics;
+}st_RecordLogHandle;
+
+/* Position of a read of the whole log, from the oldest record to the newest */
+typedef struct st_RecordLogCursor
+{
+	uint16_t  page;				/* Index in the ring */
+	uint16_t  remaining;		/* Pages left to read, the current one included */
+	uint8_t   offset;			/* Next record in the page, 0 until the page is loaded */
+	uint8_t   pageBuffer[RECORDLOG_PAGE_SIZE];
+}st_RecordLogCursor;
+
+/* Function Declaration -------------------------------*/
+
+/**
+ * @brief Initializes the record log and mounts it.
+ *
+ * The head page is found by a binary search over the sequence numbers of the pages (about
+ * log2(pageCount) header reads), then only the head page is read to find the end of its records.
+ * Erased pages are an empty log, pages holding other data must be formatted with RECORDLOG_Format().
+ * When a reset tore the copies of the garbage collection, the head page is started again (one
+ * page read and one page write).
+ *
+ * @param[in] log Context of the record log, owned by the application.
+ * @param[in] eeprom Initialized EEPROM holding the log.
+ * @param[in] firstPage First EEPROM page of the log.
+ * @param[in] pageCount Number of pages of the log, at least RECORDLOG_PAGE_MIN.
+ * @return e_Status STATUS_OK if mounted (empty or not), STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_Init(st_RecordLogHandle *log, st_AT24C256Handle *eeprom, uint16_t firstPage, uint16_t pageCount);
+
+/**
+ * @brief Erases all the pages of the log.
+ *
+ * One write cycle per page, needed once before the first use of a range of pages.
+ *
+ * @param[in] log Context of the record log.
+ * @return e_Status STATUS_OK if erased, STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_Format(st_RecordLogHandle *log);
+
+/**
+ * @brief Appends a record to the log.
+ *
+ * The record is added to the head page image. When it does not fit, the head page is closed and
+ * the next page of the ring is started, with the latest records of the page reused after it
+ * copied forward. With RECORDLOG_WRITE_THROUGH the record is written to the EEPROM before the
+ * return (one write cycle), otherwise it is written by RECORDLOG_Flush() or when the page is full.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] key Key of the record, RECORDLOG_KEY_STREAM or a key below RECORDLOG_KEY_COUNT.
+ * @param[in] data Pointer to the data of the record.
+ * @param[in] size Number of bytes of the data, up to RECORDLOG_DATA_MAX.
+ * @return e_Status STATUS_OK if appended, STATUS_TIMEOUT if a write cycle did not end,
+ * 					STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_Append(st_RecordLogHandle *log, uint8_t key, const uint8_t *data, uint8_t size);
+
+/**
+ * @brief Writes the records of the head page image not yet in the EEPROM.
+ *
+ * @param[in] log Context of the record log.
+ * @return e_Status STATUS_OK if written or nothing to write, STATUS_TIMEOUT if a write cycle did
+ * 					not end, STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_Flush(st_RecordLogHandle *log);
+
+/**
+ * @brief Reads the latest record of a key.
+ *
+ * The location is cached. The first read of a key after the mount searches the pages from the
+ * head to the oldest one.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in] key Key of the record.
+ * @param[out] data Pointer to store the data of the record.
+ * @param[in] bufferSize Size of the data buffer.
+ * @param[out] readSize Pointer to store the number of bytes of the data.
+ * @return e_Status STATUS_OK if read, STATUS_NOT_OK if the key has no record, the buffer is too
+ * 					small or the read failed.
+ */
+e_Status RECORDLOG_ReadLatest(st_RecordLogHandle *log, uint8_t key, uint8_t *data, uint8_t bufferSize, uint8_t *readSize);
+
+/**
+ * @brief Starts a read of the whole log from the oldest record.
+ *
+ * @param[in] log Context of the record log.
+ * @param[out] cursor Position of the read.
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_CursorStart(st_RecordLogHandle *log, st_RecordLogCursor *cursor);
+
+/**
+ * @brief Reads the next record of the log.
+ *
+ * The records are returned in the order of their append. A latest record copied forward by the
+ * garbage collection is returned again at its new place.
+ *
+ * @param[in] log Context of the record log.
+ * @param[in,out] cursor Position of the read.
+ * @param[out] key Pointer to store the key of the record.
+ * @param[out] data Pointer to store the data of the record.
+ * @param[in] bufferSize Size of the data buffer, RECORDLOG_DATA_MAX fits any record.
+ * @param[out] readSize Pointer to store the number of bytes of the data.
+ * @return e_Status STATUS_OK if a record is read, STATUS_NOT_OK at the end of the log or on error.
+ */
+e_Status RECORDLOG_CursorNext(st_RecordLogHandle *log, st_RecordLogCursor *cursor, uint8_t *key, uint8_t *data, uint8_t bufferSize, uint8_t *readSize);
+
+/**
+ * @brief Gets the cost of the record log.
+ *
+ * @param[in] log Context of the record log.
+ * @param[out] statistics Pointer to store the statistics.
+ * @return e_Status STATUS_OK if successful, STATUS_NOT_OK otherwise.
+ */
+e_Status RECORDLOG_GetStatistics(st_RecordLogHandle *log, st_RecordLogStatistics *statistics);
+
+/**
+ * @brief Clears the cost of the record log.
+ *
+ * @param[in] log Context of the record log.
+ */
+void RECORDLOG_ResetStatistics(st_RecordLogHandle *log);
+
+
+#endif /* RECORD_LOG_H_ */
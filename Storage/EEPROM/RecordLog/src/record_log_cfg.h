@@ -0,0 +1,51 @@
+/**
+ * @file record_log_cfg.h
+ * @brief Configuration for the record log
+ *
+ * @date 2026-10-17
+ * @author jainr
+ */
+
+#ifndef RECORD_LOG_CFG_H_
+#define RECORD_LOG_CFG_H_
+
+/* Includes -------------------------------------------*/
+#include <common.h>
+#include <at24c256.h>
+
+/* Macro Definition -----------------------------------*/
+/* 1: each append is written before the return, one write cycle per record.
+ * 0: the appends are gathered in the head page image, one write cycle per page or per RECORDLOG_Flush(),
+ *    the records not flushed are lost on a reset */
+#define RECORDLOG_WRITE_THROUGH		1u
+
+/* Function Definition --------------------------------*/
+/*
+ * @brief  Writes data to the EEPROM holding the log.
+ * @note   The log never writes across a page, one write cycle per call.
+ * @param  eeprom          EEPROM holding the log.
+ * @param  memoryAddr      Memory address to write data.
+ * @param  writeDataBuffer Pointer to the data buffer to be written.
+ * @param  writeDataSize   Size of the data to be written.
+ * @retval e_Status  Status of the write operation (STATUS_OK, STATUS_TIMEOUT or STATUS_NOT_OK).
+ */
+e_Status RECORDLOG_DeviceWrite(st_AT24C256Handle *eeprom, uint16_t memoryAddr, const uint8_t *writeDataBuffer, uint16_t writeDataSize)
+{
+    return AT24C256_Write(eeprom, memoryAddr, writeDataBuffer, writeDataSize);
+}
+
+/*
+ * @brief  Reads data from the EEPROM holding the log.
+ * @param  eeprom          EEPROM holding the log.
+ * @param  memoryAddr      Memory address to read data from.
+ * @param  readDataBuffer  Pointer to the data buffer to store the read data.
+ * @param  readDataSize    Size of the data to be read.
+ * @retval e_Status  Status of the read operation (STATUS_OK, STATUS_TIMEOUT or STATUS_NOT_OK).
+ */
+e_Status RECORDLOG_DeviceRead(st_AT24C256Handle *eeprom, uint16_t memoryAddr, uint8_t *readDataBuffer, uint16_t readDataSize)
+{
+    return AT24C256_Read(eeprom, memoryAddr, readDataBuffer, readDataSize);
+}
+
+
+#endif /* RECORD_LOG_CFG_H_ */